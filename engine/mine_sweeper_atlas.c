@@ -0,0 +1,112 @@
+#include "mine_sweeper_atlas.h"
+
+#include <furi.h>
+#include <math.h>
+
+// Grid the atlas is measured on; together they span every supported board size.
+const uint8_t minesweeper_atlas_widths[MINESWEEPER_ATLAS_WIDTH_COUNT] = {16, 20, 24, 28, 32};
+const uint8_t minesweeper_atlas_heights[MINESWEEPER_ATLAS_HEIGHT_COUNT] =
+    {7, 8, 12, 16, 20, 24, 28, 32};
+
+// Rejection sampling is kept while a board from it costs at most this many
+// constructive boards.
+#define ATLAS_REJECTION_MAX_COST_RATIO (8.0f)
+
+// Finds the grid cell holding value and how far into it value lies.
+static uint8_t minesweeper_atlas_axis_cell(
+    const uint8_t* axis,
+    uint8_t count,
+    uint8_t value,
+    float* fraction) {
+    uint8_t cell = 0;
+    while (cell + 2u < count && value >= axis[cell + 1u]) {
+        cell++;
+    }
+
+    if (value <= axis[cell]) {
+        *fraction = 0.0f;
+    } else if (value >= axis[cell + 1u]) {
+        *fraction = 1.0f;
+    } else {
+        *fraction = (float)(value - axis[cell]) / (float)(axis[cell + 1u] - axis[cell]);
+    }
+
+    return cell;
+}
+
+void minesweeper_atlas_estimate(
+    uint8_t width,
+    uint8_t height,
+    uint8_t difficulty,
+    MineSweeperAtlasEstimate* estimate) {
+    furi_assert(estimate);
+
+    if (difficulty >= MINESWEEPER_DIFFICULTY_COUNT) {
+        difficulty = MINESWEEPER_DIFFICULTY_COUNT - 1;
+    }
+
+    float fx = 0.0f;
+    float fy = 0.0f;
+    const uint8_t x = minesweeper_atlas_axis_cell(
+        minesweeper_atlas_widths, MINESWEEPER_ATLAS_WIDTH_COUNT, width, &fx);
+    const uint8_t y = minesweeper_atlas_axis_cell(
+        minesweeper_atlas_heights, MINESWEEPER_ATLAS_HEIGHT_COUNT, height, &fy);
+
+    const MineSweeperAtlasEntry* corners[4] = {
+        &minesweeper_atlas_table[difficulty][y][x],
+        &minesweeper_atlas_table[difficulty][y][x + 1u],
+        &minesweeper_atlas_table[difficulty][y + 1u][x],
+        &minesweeper_atlas_table[difficulty][y + 1u][x + 1u],
+    };
+    const float weights[4] = {
+        (1.0f - fx) * (1.0f - fy),
+        fx * (1.0f - fy),
+        (1.0f - fx) * fy,
+        fx * fy,
+    };
+
+    for (uint8_t s = 0; s < MineSweeperStrategyCount; s++) {
+        float log_accept = 0.0f;
+        float cost = 0.0f;
+        bool never = false;
+
+        for (uint8_t c = 0; c < 4; c++) {
+            if (weights[c] == 0.0f) {
+                continue;
+            }
+            // A strategy that never succeeded next to this size is not trusted here either.
+            if (corners[c]->accept_q16[s] == 0) {
+                never = true;
+            } else {
+                log_accept += weights[c] * logf(corners[c]->accept_q16[s] / 65536.0f);
+            }
+            cost += weights[c] * corners[c]->cost_us_q2[s] / 4.0f;
+        }
+
+        estimate->accept[s] = never ? 0.0f : expf(log_accept);
+        estimate->cost_us[s] = cost;
+    }
+}
+
+MineSweeperStrategy minesweeper_atlas_pick_strategy(const MineSweeperAtlasEstimate* estimate) {
+    furi_assert(estimate);
+
+    const float rejection_accept = estimate->accept[MineSweeperStrategyRejection];
+    const float constructive_accept = estimate->accept[MineSweeperStrategyConstructive];
+
+    if (constructive_accept <= 0.0f) {
+        return MineSweeperStrategyRejection;
+    }
+    if (rejection_accept <= 0.0f) {
+        return MineSweeperStrategyConstructive;
+    }
+
+    const float rejection_per_board =
+        estimate->cost_us[MineSweeperStrategyRejection] / rejection_accept;
+    const float constructive_per_board =
+        estimate->cost_us[MineSweeperStrategyConstructive] / constructive_accept;
+
+    return rejection_per_board <= ATLAS_REJECTION_MAX_COST_RATIO * constructive_per_board ?
+               MineSweeperStrategyRejection :
+               MineSweeperStrategyConstructive;
+}
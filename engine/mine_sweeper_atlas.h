@@ -0,0 +1,66 @@
+#ifndef MINE_SWEEPER_ATLAS_H
+#define MINE_SWEEPER_ATLAS_H
+
+#include "mine_sweeper_engine.h"
+#include "mine_sweeper_strategy.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+
+/** Solvability atlas.
+  *
+  * How long a solvable board takes depends almost entirely on its size and
+  * difficulty: a 16x7 Easy board is accepted every ~10 random attempts, a
+  * 32x32 Hard one every ~800. The atlas holds, for a grid of sizes per
+  * difficulty, the share of attempts that give a board solvable from the top
+  * left tile and the mean cost of one attempt, for each generation strategy.
+  * Sizes between grid points are interpolated.
+  *
+  * The table in mine_sweeper_atlas_table.c is measured on a desktop by
+  * tools/atlas_builder from these same engine sources; costs are desktop
+  * timings and only meaningful relative to each other.
+  */
+
+#define MINESWEEPER_ATLAS_WIDTH_COUNT  (5u)
+#define MINESWEEPER_ATLAS_HEIGHT_COUNT (8u)
+
+typedef struct {
+    // Share of attempts that gave a solvable board, Q16; 0 if none did
+    uint16_t accept_q16[MineSweeperStrategyCount];
+    // Mean desktop time of one attempt, microseconds << 2
+    uint16_t cost_us_q2[MineSweeperStrategyCount];
+} MineSweeperAtlasEntry;
+
+extern const uint8_t minesweeper_atlas_widths[MINESWEEPER_ATLAS_WIDTH_COUNT];
+extern const uint8_t minesweeper_atlas_heights[MINESWEEPER_ATLAS_HEIGHT_COUNT];
+
+/* Generated, see tools/atlas_builder. */
+extern const MineSweeperAtlasEntry minesweeper_atlas_table[MINESWEEPER_DIFFICULTY_COUNT]
+                                                          [MINESWEEPER_ATLAS_HEIGHT_COUNT]
+                                                          [MINESWEEPER_ATLAS_WIDTH_COUNT];
+
+typedef struct {
+    float accept[MineSweeperStrategyCount]; // 0 when the strategy never succeeded
+    float cost_us[MineSweeperStrategyCount];
+} MineSweeperAtlasEstimate;
+
+/* Interpolates the atlas at any supported size: acceptance geometrically,
+ * cost linearly. */
+void minesweeper_atlas_estimate(
+    uint8_t width,
+    uint8_t height,
+    uint8_t difficulty,
+    MineSweeperAtlasEstimate* estimate);
+
+/* Rejection sampling yields every solvable layout with equal odds, so it is
+ * kept until its expected cost per board runs well past the constructive
+ * generator's, whose repaired boards are slightly less varied. */
+MineSweeperStrategy minesweeper_atlas_pick_strategy(const MineSweeperAtlasEstimate* estimate);
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+#endif // MINE_SWEEPER_ATLAS_H
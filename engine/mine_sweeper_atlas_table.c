@@ -0,0 +1,242 @@
+// Generated by tools/atlas_builder (up to 64 solvable boards or 1.5s per
+// strategy and cell); do not edit. Entries are
+// {{rejection, constructive} accept_q16}, {{rejection, constructive} cost_us_q2}.
+
+#include "mine_sweeper_atlas.h"
+
+const MineSweeperAtlasEntry minesweeper_atlas_table[MINESWEEPER_DIFFICULTY_COUNT]
+                                                   [MINESWEEPER_ATLAS_HEIGHT_COUNT]
+                                                   [MINESWEEPER_ATLAS_WIDTH_COUNT] = {
+    {
+        {
+            {{19973, 59919}, {65, 209}}, // 16x7
+            {{13935, 57456}, {75, 317}}, // 20x7
+            {{15534, 53092}, {99, 374}}, // 24x7
+            {{16644, 53092}, {112, 443}}, // 28x7
+            {{15828, 53092}, {116, 431}}, // 32x7
+        },
+        {
+            {{20165, 56680}, {80, 226}}, // 16x8
+            {{16384, 56680}, {104, 289}}, // 20x8
+            {{17261, 57456}, {100, 397}}, // 24x8
+            {{16009, 58254}, {123, 417}}, // 28x8
+            {{13066, 59919}, {160, 580}}, // 32x8
+        },
+        {
+            {{26052, 53092}, {112, 273}}, // 16x12
+            {{18893, 56680}, {129, 349}}, // 20x12
+            {{23831, 53092}, {163, 447}}, // 24x12
+            {{18725, 55924}, {151, 577}}, // 28x12
+            {{23046, 53773}, {183, 579}}, // 32x12
+        },
+        {
+            {{22429, 58254}, {104, 339}}, // 16x16
+            {{19878, 54471}, {119, 427}}, // 20x16
+            {{23697, 55924}, {186, 567}}, // 24x16
+            {{18893, 55188}, {180, 650}}, // 28x16
+            {{23564, 53092}, {234, 613}}, // 32x16
+        },
+        {
+            {{21183, 57456}, {141, 375}}, // 16x20
+            {{19600, 57456}, {170, 536}}, // 20x20
+            {{20662, 57456}, {214, 587}}, // 24x20
+            {{19329, 53092}, {235, 814}}, // 28x20
+            {{15142, 56680}, {235, 813}}, // 32x20
+        },
+        {
+            {{19065, 54471}, {161, 521}}, // 16x24
+            {{21400, 54471}, {204, 624}}, // 20x24
+            {{16513, 54471}, {248, 816}}, // 24x24
+            {{19418, 52429}, {253, 843}}, // 28x24
+            {{14873, 49345}, {303, 909}}, // 32x24
+        },
+        {
+            {{16845, 55188}, {258, 670}}, // 16x28
+            {{21183, 56680}, {229, 734}}, // 20x28
+            {{20460, 52429}, {210, 715}}, // 24x28
+            {{19878, 51150}, {259, 879}}, // 28x28
+            {{14665, 48771}, {225, 1012}}, // 32x28
+        },
+        {
+            {{18979, 53773}, {168, 494}}, // 16x32
+            {{18893, 53773}, {199, 740}}, // 20x32
+            {{21183, 53092}, {287, 833}}, // 24x32
+            {{18725, 52429}, {283, 862}}, // 28x32
+            {{18477, 47127}, {282, 2076}}, // 32x32
+        },
+    },
+    {
+        {
+            {{14413, 51150}, {54, 188}}, // 16x7
+            {{10755, 54471}, {57, 254}}, // 20x7
+            {{10082, 47127}, {66, 339}}, // 24x7
+            {{8355, 49345}, {75, 343}}, // 28x7
+            {{7739, 53092}, {80, 496}}, // 32x7
+        },
+        {
+            {{14364, 57456}, {64, 280}}, // 16x8
+            {{10255, 54471}, {67, 410}}, // 20x8
+            {{12228, 53092}, {100, 437}}, // 24x8
+            {{8812, 49932}, {87, 618}}, // 28x8
+            {{7371, 47127}, {102, 669}}, // 32x8
+        },
+        {
+            {{13190, 49932}, {87, 383}}, // 16x12
+            {{12336, 55188}, {115, 462}}, // 20x12
+            {{13231, 52429}, {152, 544}}, // 24x12
+            {{12866, 53092}, {158, 657}}, // 28x12
+            {{13358, 49932}, {172, 772}}, // 32x12
+        },
+        {
+            {{14028, 51150}, {117, 417}}, // 16x16
+            {{13888, 51150}, {130, 547}}, // 20x16
+            {{12985, 53092}, {164, 700}}, // 24x16
+            {{14170, 52429}, {160, 724}}, // 28x16
+            {{12087, 49932}, {190, 910}}, // 32x16
+        },
+        {
+            {{13797, 50534}, {144, 558}}, // 16x20
+            {{13707, 46603}, {168, 771}}, // 20x20
+            {{13190, 51782}, {180, 879}}, // 24x20
+            {{13797, 49932}, {181, 1073}}, // 28x20
+            {{12193, 51782}, {214, 833}}, // 32x20
+        },
+        {
+            {{13273, 49932}, {145, 618}}, // 16x24
+            {{14980, 47663}, {170, 654}}, // 20x24
+            {{12300, 49932}, {195, 746}}, // 24x24
+            {{13358, 52429}, {208, 1081}}, // 28x24
+            {{11460, 48210}, {302, 1418}}, // 32x24
+        },
+        {
+            {{11749, 47127}, {163, 673}}, // 16x28
+            {{12520, 50534}, {196, 1061}}, // 20x28
+            {{11916, 52429}, {246, 1331}}, // 24x28
+            {{9533, 50534}, {316, 1456}}, // 28x28
+            {{10923, 48210}, {338, 1349}}, // 32x28
+        },
+        {
+            {{11460, 48771}, {202, 828}}, // 16x32
+            {{12827, 50534}, {202, 1055}}, // 20x32
+            {{10082, 46603}, {217, 1172}}, // 24x32
+            {{9823, 53092}, {280, 1697}}, // 28x32
+            {{12336, 47663}, {295, 1423}}, // 32x32
+        },
+    },
+    {
+        {
+            {{8886, 49932}, {45, 234}}, // 16x7
+            {{5907, 52429}, {52, 318}}, // 20x7
+            {{5357, 55924}, {60, 437}}, // 24x7
+            {{3000, 51782}, {70, 750}}, // 28x7
+            {{2903, 45590}, {75, 693}}, // 32x7
+        },
+        {
+            {{6473, 46603}, {50, 367}}, // 16x8
+            {{6088, 47127}, {54, 395}}, // 20x8
+            {{4883, 44151}, {73, 614}}, // 24x8
+            {{3792, 47663}, {82, 765}}, // 28x8
+            {{3170, 45590}, {91, 722}}, // 32x8
+        },
+        {
+            {{10408, 48210}, {71, 409}}, // 16x12
+            {{7158, 44620}, {92, 530}}, // 20x12
+            {{7307, 55188}, {104, 749}}, // 24x12
+            {{6463, 48771}, {112, 942}}, // 28x12
+            {{5754, 46091}, {118, 851}}, // 32x12
+        },
+        {
+            {{7796, 47127}, {94, 665}}, // 16x16
+            {{8144, 49932}, {187, 853}}, // 20x16
+            {{6967, 51782}, {161, 1196}}, // 24x16
+            {{6088, 49345}, {197, 1358}}, // 28x16
+            {{6689, 46091}, {171, 1312}}, // 32x16
+        },
+        {
+            {{8422, 49932}, {112, 880}}, // 16x20
+            {{7232, 49345}, {149, 1076}}, // 20x20
+            {{7571, 48771}, {204, 1524}}, // 24x20
+            {{6177, 45100}, {220, 1340}}, // 28x20
+            {{6279, 44620}, {251, 1410}}, // 32x20
+        },
+        {
+            {{6070, 47127}, {149, 956}}, // 16x24
+            {{7914, 45590}, {215, 1651}}, // 20x24
+            {{6944, 47663}, {245, 1462}}, // 24x24
+            {{6288, 48210}, {324, 1850}}, // 28x24
+            {{4946, 48771}, {291, 2318}}, // 32x24
+        },
+        {
+            {{5916, 51150}, {199, 1664}}, // 16x28
+            {{7158, 49345}, {253, 1985}}, // 20x28
+            {{5891, 45100}, {296, 2296}}, // 24x28
+            {{6018, 48210}, {336, 2731}}, // 28x28
+            {{6079, 41121}, {349, 2384}}, // 32x28
+        },
+        {
+            {{5592, 44151}, {174, 1369}}, // 16x32
+            {{5011, 45590}, {166, 1459}}, // 20x32
+            {{5699, 46603}, {223, 1889}}, // 24x32
+            {{5933, 47663}, {292, 2387}}, // 28x32
+            {{5153, 39569}, {297, 2275}}, // 32x32
+        },
+    },
+    {
+        {
+            {{1989, 45100}, {41, 415}}, // 16x7
+            {{1436, 36472}, {41, 440}}, // 20x7
+            {{1107, 42799}, {56, 987}}, // 24x7
+            {{424, 41943}, {67, 738}}, // 28x7
+            {{385, 37449}, {62, 1276}}, // 32x7
+        },
+        {
+            {{2219, 40721}, {54, 571}}, // 16x8
+            {{1243, 39946}, {54, 805}}, // 20x8
+            {{905, 41943}, {64, 898}}, // 24x8
+            {{711, 35849}, {67, 1139}}, // 28x8
+            {{264, 41121}, {74, 1639}}, // 32x8
+        },
+        {
+            {{2453, 43240}, {86, 1007}}, // 16x12
+            {{2182, 41943}, {106, 1131}}, // 20x12
+            {{1286, 49345}, {95, 1560}}, // 24x12
+            {{1087, 41528}, {108, 1864}}, // 28x12
+            {{816, 38836}, {103, 2638}}, // 32x12
+        },
+        {
+            {{1976, 39946}, {96, 945}}, // 16x16
+            {{1676, 41121}, {100, 1221}}, // 20x16
+            {{1237, 47127}, {104, 2333}}, // 24x16
+            {{952, 42367}, {150, 2076}}, // 28x16
+            {{1125, 37449}, {141, 2645}}, // 32x16
+        },
+        {
+            {{1627, 43691}, {91, 1400}}, // 16x20
+            {{1887, 37118}, {123, 2084}}, // 20x20
+            {{1021, 38480}, {148, 2745}}, // 24x20
+            {{745, 45100}, {164, 3205}}, // 28x20
+            {{654, 34953}, {171, 3320}}, // 32x20
+        },
+        {
+            {{1859, 49345}, {126, 1955}}, // 16x24
+            {{1262, 38480}, {145, 2243}}, // 20x24
+            {{1200, 40721}, {172, 3296}}, // 24x24
+            {{1059, 37449}, {194, 3732}}, // 28x24
+            {{888, 43691}, {209, 5443}}, // 32x24
+        },
+        {
+            {{906, 37449}, {145, 2635}}, // 16x28
+            {{753, 37118}, {189, 3445}}, // 20x28
+            {{779, 35545}, {188, 3862}}, // 24x28
+            {{849, 34100}, {227, 5374}}, // 28x28
+            {{579, 39199}, {232, 6517}}, // 32x28
+        },
+        {
+            {{1073, 49345}, {150, 3272}}, // 16x32
+            {{980, 43240}, {227, 3937}}, // 20x32
+            {{823, 35545}, {229, 4548}}, // 24x32
+            {{675, 35849}, {264, 6054}}, // 28x32
+            {{552, 36792}, {281, 7157}}, // 32x32
+        },
+    },
+};
@@ -0,0 +1,120 @@
+#ifndef MINE_SWEEPER_BOARD_PACK_FORMAT_H
+#define MINE_SWEEPER_BOARD_PACK_FORMAT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+
+/** Board pack file layout (all integers little endian).
+  *
+  *   header   16 bytes   magic "MSBP", u16 version, u16 group_count, u32 pack_id, u32 reserved
+  *   index    16 bytes per group, right after the header:
+  *            u8 width, u8 height, u8 difficulty, u8 reserved,
+  *            u16 board_stride, u16 mine_count, u32 board_count, u32 offset
+  *   boards   board_count fixed size slots of board_stride bytes per group,
+  *            starting at that group's offset
+  *
+  * In version 1 a slot holds a packed mine bitmap in board_pack_mines order
+  * and mine_count is unused. In version 2 a slot holds a board_codec encoding
+  * of mine_count mines, zero padded to the group's longest encoding. Every board
+  * in a pack is solvable from the start tile without guessing, so a reader
+  * only ever needs the header, one index entry and one slot. Boards are stored
+  * canonically (solvable from the top left tile) and the device also plays
+  * their reflections and rotations, so a pack should not hold two boards that
+  * are transforms of each other.
+  * pack_id changes whenever a pack is rebuilt, which resets the consumed-board
+  * cursors kept on the device.
+  */
+
+#define BOARD_PACK_MAGIC        "MSBP"
+#define BOARD_PACK_VERSION_RAW  (1u)
+#define BOARD_PACK_VERSION      (2u)
+#define BOARD_PACK_HEADER_SIZE  (16u)
+#define BOARD_PACK_GROUP_SIZE   (16u)
+#define BOARD_PACK_MAX_GROUPS   (256u)
+
+typedef struct {
+    uint16_t version;
+    uint16_t group_count;
+    uint32_t pack_id;
+} BoardPackHeader;
+
+typedef struct {
+    uint8_t width;
+    uint8_t height;
+    uint8_t difficulty;
+    uint16_t board_stride;
+    uint16_t mine_count;
+    uint32_t board_count;
+    uint32_t offset;
+} BoardPackGroup;
+
+static inline uint16_t board_pack_get_u16(const uint8_t* p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static inline uint32_t board_pack_get_u32(const uint8_t* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) |
+           ((uint32_t)p[3] << 24);
+}
+
+static inline void board_pack_put_u16(uint8_t* p, uint16_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static inline void board_pack_put_u32(uint8_t* p, uint32_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+static inline bool board_pack_parse_header(const uint8_t* raw, BoardPackHeader* header) {
+    if (memcmp(raw, BOARD_PACK_MAGIC, 4) != 0) return false;
+
+    header->version = board_pack_get_u16(raw + 4);
+    header->group_count = board_pack_get_u16(raw + 6);
+    header->pack_id = board_pack_get_u32(raw + 8);
+
+    return header->group_count <= BOARD_PACK_MAX_GROUPS;
+}
+
+static inline void board_pack_write_header(uint8_t* raw, const BoardPackHeader* header) {
+    memset(raw, 0, BOARD_PACK_HEADER_SIZE);
+    memcpy(raw, BOARD_PACK_MAGIC, 4);
+    board_pack_put_u16(raw + 4, header->version);
+    board_pack_put_u16(raw + 6, header->group_count);
+    board_pack_put_u32(raw + 8, header->pack_id);
+}
+
+static inline void board_pack_parse_group(const uint8_t* raw, BoardPackGroup* group) {
+    group->width = raw[0];
+    group->height = raw[1];
+    group->difficulty = raw[2];
+    group->board_stride = board_pack_get_u16(raw + 4);
+    group->mine_count = board_pack_get_u16(raw + 6);
+    group->board_count = board_pack_get_u32(raw + 8);
+    group->offset = board_pack_get_u32(raw + 12);
+}
+
+static inline void board_pack_write_group(uint8_t* raw, const BoardPackGroup* group) {
+    memset(raw, 0, BOARD_PACK_GROUP_SIZE);
+    raw[0] = group->width;
+    raw[1] = group->height;
+    raw[2] = group->difficulty;
+    board_pack_put_u16(raw + 4, group->board_stride);
+    board_pack_put_u16(raw + 6, group->mine_count);
+    board_pack_put_u32(raw + 8, group->board_count);
+    board_pack_put_u32(raw + 12, group->offset);
+}
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+#endif // MINE_SWEEPER_BOARD_PACK_FORMAT_H
@@ -0,0 +1,126 @@
+#include "mine_sweeper_board_pool.h"
+#include <furi.h>
+#include <string.h>
+
+// Fields that decide what a board looks like; wrap only affects cursor movement and
+// pooled boards are canonical, so the start corner is picked when one is taken.
+static bool board_pool_config_matches(const MineSweeperConfig* a, const MineSweeperConfig* b) {
+    return a->width == b->width && a->height == b->height && a->difficulty == b->difficulty &&
+           a->ensure_solvable == b->ensure_solvable && a->bbbv_min == b->bbbv_min &&
+           a->bbbv_max == b->bbbv_max;
+}
+
+void board_pool_init(MineSweeperBoardPool* pool) {
+    furi_assert(pool);
+
+    memset(pool, 0, sizeof(*pool));
+}
+
+void board_pool_set_config(MineSweeperBoardPool* pool, const MineSweeperConfig* config) {
+    furi_assert(pool);
+    furi_assert(config);
+
+    if (pool->has_config && board_pool_config_matches(&pool->config, config)) {
+        pool->config.wrap_enabled = config->wrap_enabled;
+        pool->config.start_corner = config->start_corner;
+        return;
+    }
+
+    pool->config = *config;
+    pool->has_config = true;
+    pool->head = 0;
+    pool->count = 0;
+
+    // Restart the refill on the next step rather than finishing a stale board.
+    minesweeper_engine_generation_cancel(&pool->refill_job);
+}
+
+bool board_pool_is_full(const MineSweeperBoardPool* pool) {
+    furi_assert(pool);
+
+    return pool->count >= BOARD_POOL_CAPACITY;
+}
+
+static void board_pool_pop(MineSweeperBoardPool* pool) {
+    pool->head = (pool->head + 1u) % BOARD_POOL_CAPACITY;
+    pool->count--;
+}
+
+bool board_pool_take(
+    MineSweeperBoardPool* pool,
+    const MineSweeperConfig* config,
+    uint8_t* mines_out,
+    MineSweeperTransform* transform_out) {
+    furi_assert(pool);
+    furi_assert(config);
+    furi_assert(mines_out);
+    furi_assert(transform_out);
+
+    if (!pool->has_config || !board_pool_config_matches(&pool->config, config)) {
+        return false;
+    }
+
+    while (pool->count > 0) {
+        uint8_t* used = &pool->used[pool->head];
+        const MineSweeperTransform transform =
+            board_pick_transform(config->width, config->height, config->start_corner, *used);
+
+        if (transform == MineSweeperTransformCount) {
+            // Only variants for other corners are left on this one.
+            board_pool_pop(pool);
+            continue;
+        }
+
+        memcpy(mines_out, pool->mines[pool->head], BOARD_MINE_BITMAP_BYTES);
+        *used |= (uint8_t)(1u << transform);
+        *transform_out = transform;
+
+        if (board_pick_transform(config->width, config->height, config->start_corner, *used) ==
+            MineSweeperTransformCount) {
+            board_pool_pop(pool);
+        }
+
+        return true;
+    }
+
+    return false;
+}
+
+MineSweeperGenerationJob* board_pool_refill_job(MineSweeperBoardPool* pool) {
+    furi_assert(pool);
+
+    if (!pool->has_config || board_pool_is_full(pool)) {
+        return NULL;
+    }
+
+    MineSweeperGenerationJob* job = &pool->refill_job;
+
+    if (minesweeper_engine_generation_status(job) != MineSweeperGenerationStatusInProgress &&
+        minesweeper_engine_generation_begin(job, &pool->config) == MineSweeperResultInvalid) {
+        // Nothing sensible to pregenerate for this config.
+        pool->has_config = false;
+        return NULL;
+    }
+
+    return job;
+}
+
+bool board_pool_refill_collect(MineSweeperBoardPool* pool) {
+    furi_assert(pool);
+
+    MineSweeperGenerationJob* job = &pool->refill_job;
+
+    // A board finished for a config dropped meanwhile is thrown away; the next
+    // refill begins one for the new config.
+    if (minesweeper_engine_generation_status(job) == MineSweeperGenerationStatusReady &&
+        pool->has_config && board_pool_config_matches(&pool->config, &job->config) &&
+        !board_pool_is_full(pool)) {
+        const uint8_t tail = (pool->head + pool->count) % BOARD_POOL_CAPACITY;
+        board_pack_mines(&job->latest_candidate.board, pool->mines[tail]);
+        pool->used[tail] = 0;
+        // The job is no longer in progress, so the next refill begins a fresh board.
+        pool->count++;
+    }
+
+    return pool->has_config && !board_pool_is_full(pool);
+}
@@ -0,0 +1,66 @@
+#ifndef MINE_SWEEPER_BOARD_POOL_H
+#define MINE_SWEEPER_BOARD_POOL_H
+
+#include "mine_sweeper_engine.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+
+#define BOARD_POOL_CAPACITY (4u)
+
+/** Ring of pregenerated boards for one config, kept as packed mine bitmaps.
+  *
+  * The pool owns its own generation job so refilling can be interrupted at any
+  * point (e.g. for a foreground job) and resumed later without losing work.
+  * Boards are only pooled if they pass the same acceptance test as a normal
+  * generation, so taking one is as good as waiting for the generating screen.
+  *
+  * Boards are kept canonical and handed out once per transform (see
+  * MineSweeperTransform), so a board stays in the pool until every variant
+  * that starts from the configured corner has been played.
+  */
+typedef struct {
+    MineSweeperConfig config;
+    bool has_config;
+    uint8_t head;
+    uint8_t count;
+    uint8_t mines[BOARD_POOL_CAPACITY][BOARD_MINE_BITMAP_BYTES];
+    uint8_t used[BOARD_POOL_CAPACITY]; // bit per transform already handed out
+    MineSweeperGenerationJob refill_job;
+} MineSweeperBoardPool;
+
+void board_pool_init(MineSweeperBoardPool* pool);
+
+/** Points the pool at a config. Boards for any other config are dropped. */
+void board_pool_set_config(MineSweeperBoardPool* pool, const MineSweeperConfig* config);
+
+bool board_pool_is_full(const MineSweeperBoardPool* pool);
+
+/** Hands out an unplayed variant of the oldest board if the pool holds boards
+  * for this config: the canonical bitmap plus the transform to load it with.
+  * The board is dropped once no variant for the config's start corner is left.
+  */
+bool board_pool_take(
+    MineSweeperBoardPool* pool,
+    const MineSweeperConfig* config,
+    uint8_t* mines_out,
+    MineSweeperTransform* transform_out);
+
+/** The refill job to step next, begun for the pool's config unless it is already
+  * running, or NULL while the pool is full or has nothing to pregenerate. It may
+  * be stepped without holding whatever guards the pool, as long as nothing else
+  * steps it; board_pool_set_config only cancels it. */
+MineSweeperGenerationJob* board_pool_refill_job(MineSweeperBoardPool* pool);
+
+/** Pools the refill job's board once it is ready and still matches the pool's
+  * config. Returns true while the pool still wants boards. */
+bool board_pool_refill_collect(MineSweeperBoardPool* pool);
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+#endif // MINE_SWEEPER_BOARD_POOL_H
@@ -0,0 +1,203 @@
+#include "mine_sweeper_codec.h"
+#include <furi.h>
+#include <string.h>
+
+// Same normalisation as the LZMA range coder: keep at least 24 bits of range.
+#define CODEC_TOP_VALUE (1u << 24)
+
+static inline bool codec_bit_test(const uint8_t* bitmap, uint16_t i) {
+    return (bitmap[i >> 3u] & (uint8_t)(1u << (i & 0x07u))) != 0u;
+}
+
+static inline void codec_bit_set(uint8_t* bitmap, uint16_t i) {
+    bitmap[i >> 3u] |= (uint8_t)(1u << (i & 0x07u));
+}
+
+// Share of the range given to "mine". range >= 2^24 and tiles_left <= 1024, so
+// the slice is never empty and the rounding loss is far below a bit per board.
+static inline uint32_t codec_mine_bound(uint32_t range, uint16_t mines_left, uint16_t tiles_left) {
+    return (range / tiles_left) * mines_left;
+}
+
+typedef struct {
+    uint64_t low;
+    uint32_t range;
+    uint8_t cache;
+    uint32_t cache_size;
+    bool skip_first;
+    uint8_t* out;
+    uint16_t capacity;
+    uint16_t size;
+    bool overflow;
+} CodecEncoder;
+
+static void codec_encoder_emit(CodecEncoder* enc, uint8_t byte) {
+    // The first byte out of this coder is always zero, so it is never stored.
+    if (enc->skip_first) {
+        furi_assert(byte == 0);
+        enc->skip_first = false;
+        return;
+    }
+
+    if (enc->size >= enc->capacity) {
+        enc->overflow = true;
+        return;
+    }
+
+    enc->out[enc->size++] = byte;
+}
+
+static void codec_encoder_shift_low(CodecEncoder* enc) {
+    if ((uint32_t)enc->low < 0xFF000000u || (enc->low >> 32) != 0) {
+        const uint8_t carry = (uint8_t)(enc->low >> 32);
+        uint8_t temp = enc->cache;
+
+        do {
+            codec_encoder_emit(enc, (uint8_t)(temp + carry));
+            temp = 0xFF;
+        } while (--enc->cache_size != 0);
+
+        enc->cache = (uint8_t)(enc->low >> 24);
+    }
+
+    enc->cache_size++;
+    enc->low = (enc->low & 0x00FFFFFFu) << 8;
+}
+
+bool board_codec_encode(
+    const uint8_t* mines,
+    uint16_t tile_count,
+    uint16_t mine_count,
+    uint8_t* out,
+    uint16_t out_capacity,
+    uint16_t* out_size) {
+    furi_assert(mines);
+    furi_assert(out);
+    furi_assert(out_size);
+    furi_assert(tile_count <= BOARD_MAX_TILES);
+
+    CodecEncoder enc = {
+        .low = 0,
+        .range = 0xFFFFFFFFu,
+        .cache = 0,
+        .cache_size = 1,
+        .skip_first = true,
+        .out = out,
+        .capacity = out_capacity,
+    };
+
+    uint16_t mines_left = mine_count;
+    uint16_t i = 0;
+
+    for (; i < tile_count && mines_left != 0; ++i) {
+        const uint16_t tiles_left = tile_count - i;
+        const bool is_mine = codec_bit_test(mines, i);
+
+        if (mines_left == tiles_left) {
+            // Only mines left; nothing to code, but the bitmap must agree.
+            if (!is_mine) return false;
+            mines_left--;
+            continue;
+        }
+
+        const uint32_t bound = codec_mine_bound(enc.range, mines_left, tiles_left);
+
+        if (is_mine) {
+            enc.range = bound;
+            mines_left--;
+        } else {
+            enc.low += bound;
+            enc.range -= bound;
+        }
+
+        while (enc.range < CODEC_TOP_VALUE) {
+            enc.range <<= 8;
+            codec_encoder_shift_low(&enc);
+        }
+    }
+
+    if (mines_left != 0) {
+        return false;
+    }
+
+    // The tiles after the last mine are implied clear, so a stray mine there would be lost.
+    for (; i < tile_count; ++i) {
+        if (codec_bit_test(mines, i)) return false;
+    }
+
+    // Any value in [low, low + range) decodes the same, and the decoder reads
+    // zeros past the end, so flush the one with the most trailing zero bytes
+    // and drop those bytes.
+    for (uint8_t shift = 32; shift > 0; shift -= 8) {
+        const uint64_t mask = ((uint64_t)1 << shift) - 1u;
+        const uint64_t rounded = (enc.low + mask) & ~mask;
+        if (rounded - enc.low < enc.range) {
+            enc.low = rounded;
+            break;
+        }
+    }
+
+    for (uint8_t n = 0; n < 5; ++n) {
+        codec_encoder_shift_low(&enc);
+    }
+
+    while (enc.size > 0 && enc.out[enc.size - 1] == 0) {
+        enc.size--;
+    }
+
+    *out_size = enc.size;
+    return !enc.overflow;
+}
+
+void board_codec_decode(
+    const uint8_t* in,
+    uint16_t in_size,
+    uint16_t tile_count,
+    uint16_t mine_count,
+    uint8_t* mines_out) {
+    furi_assert(in);
+    furi_assert(mines_out);
+    furi_assert(tile_count <= BOARD_MAX_TILES);
+    furi_assert(mine_count <= tile_count);
+
+    memset(mines_out, 0, (tile_count + 7u) / 8u);
+
+    uint16_t pos = 0;
+    uint32_t range = 0xFFFFFFFFu;
+    uint32_t code = 0;
+
+    for (uint8_t i = 0; i < 4; ++i) {
+        code = (code << 8) | (pos < in_size ? in[pos] : 0u);
+        pos++;
+    }
+
+    uint16_t mines_left = mine_count;
+    uint16_t i = 0;
+
+    for (; i < tile_count && mines_left != 0; ++i) {
+        const uint16_t tiles_left = tile_count - i;
+
+        if (mines_left == tiles_left) {
+            codec_bit_set(mines_out, i);
+            mines_left--;
+            continue;
+        }
+
+        const uint32_t bound = codec_mine_bound(range, mines_left, tiles_left);
+
+        if (code < bound) {
+            range = bound;
+            codec_bit_set(mines_out, i);
+            mines_left--;
+        } else {
+            code -= bound;
+            range -= bound;
+        }
+
+        while (range < CODEC_TOP_VALUE) {
+            range <<= 8;
+            code = (code << 8) | (pos < in_size ? in[pos] : 0u);
+            pos++;
+        }
+    }
+}
@@ -0,0 +1,53 @@
+#ifndef MINE_SWEEPER_CODEC_H
+#define MINE_SWEEPER_CODEC_H
+
+#include "mine_sweeper_engine.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+
+/** Compact mine layouts.
+  *
+  * A board with k mines among n tiles is one of C(n, k) layouts, so it needs
+  * only about log2 C(n, k) bits (~712 for 194 mines on 32x32, i.e. 89 bytes
+  * instead of 128). Tiles are range coded in order, each with the exact
+  * probability (mines left) / (tiles left). Once no mines or only mines are
+  * left the rest of the board costs nothing, and trailing zero bytes are
+  * dropped, which lands within about a byte of the bound. Decoding is a
+  * divide, a multiply and a compare per tile, with no tables.
+  *
+  * The mine count is not part of the encoding; callers keep it alongside
+  * (board packs store it per group).
+  */
+
+// Worst case (n = 1024, k = 512) plus slack for the coder's flush bytes.
+#define BOARD_CODEC_MAX_BYTES (BOARD_MINE_BITMAP_BYTES + 8u)
+
+/* Encodes a packed mine bitmap (board_pack_mines order) into out_size bytes.
+ * Fails if the bitmap does not hold exactly mine_count mines or the output
+ * does not fit. An empty encoding is valid (e.g. no mines at all). */
+bool board_codec_encode(
+    const uint8_t* mines,
+    uint16_t tile_count,
+    uint16_t mine_count,
+    uint8_t* out,
+    uint16_t out_capacity,
+    uint16_t* out_size);
+
+/* Decodes into a packed mine bitmap. Bytes past in_size read as zero, so a
+ * truncated input decodes to some valid layout rather than overrunning. */
+void board_codec_decode(
+    const uint8_t* in,
+    uint16_t in_size,
+    uint16_t tile_count,
+    uint16_t mine_count,
+    uint8_t* mines_out);
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+#endif // MINE_SWEEPER_CODEC_H
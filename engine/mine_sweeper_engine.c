@@ -1,23 +1,40 @@
 #include "mine_sweeper_engine.h"
+#include "mine_sweeper_atlas.h"
 #include "mine_sweeper_solver.h"
+#include "mine_sweeper_strategy.h"
 #include "mstarlib_helpers.h"
 
 #include <furi.h>
 #include <furi_hal.h>
+#include <limits.h>
+#include <math.h>
 #include <stdint.h>
 #include <string.h>
 
-static const float difficulty_multiplier[3] = {
+static const float difficulty_multiplier[MINESWEEPER_DIFFICULTY_COUNT] = {
     0.15f,
     0.17f,
     0.19f,
+    0.22f,
 };
 
+// 3BV of random boards per difficulty, measured on the host over 4000 boards
+// per size from 16x7 to 32x32: mean ~= tiles * mean_q10 / 1024 and
+// standard deviation ~= sqrt(tiles) * sd_q10 / 1024.
+static const uint16_t bbbv_mean_per_tile_q10[MINESWEEPER_DIFFICULTY_COUNT] = {238, 289, 333, 397};
+static const uint16_t bbbv_sd_per_root_tile_q10[MINESWEEPER_DIFFICULTY_COUNT] = {727, 799, 850, 911};
+
+// Band edges in standard deviations from the mean, so each band holds about a third.
+#define BBBV_BAND_EDGE_SD (0.43f)
+
+// Solver units run between cancel and deadline checks; a unit is one tile.
+#define MINESWEEPER_SOLVER_CHUNK_UNITS (64u)
+
 static void board_clear(MineSweeperBoard* board);
 static MineSweeperResult minesweeper_engine_reveal_all_tiles(MineSweeperState* game_state);
 
 // Bias Free Uniform Random Sample In Range [0, upper_exclusion]
-static uint16_t random_uniform_u16(uint16_t upper_exclusion) {
+uint16_t random_uniform_u16(uint16_t upper_exclusion) {
     if (upper_exclusion <= 1u) return 0u;
 
     const uint32_t range = (uint32_t)upper_exclusion;
@@ -71,16 +88,145 @@ static void board_ensure_safe_start(MineSweeperBoard* board, uint8_t safe_x, uin
     }
 }
 
-static void board_clear_solver_marks(MineSweeperBoard* board) {
+void board_pack_mines(const MineSweeperBoard* board, uint8_t* bitmap) {
     furi_assert(board);
+    furi_assert(bitmap);
 
     uint16_t total = (uint16_t)board->width * board->height;
+    point_visited_clear(bitmap, total);
+
+    for (uint16_t i = 0; i < total; ++i) {
+        if (CELL_IS_MINE(board->cells[i])) point_visited_set(bitmap, i);
+    }
+}
+
+void board_unpack_mines(
+    MineSweeperBoard* board,
+    uint8_t width,
+    uint8_t height,
+    const uint8_t* bitmap) {
+    furi_assert(board);
+    furi_assert(bitmap);
+
+    board_init(board, width, height);
+
+    uint16_t total = (uint16_t)width * height;
+    for (uint16_t i = 0; i < total; ++i) {
+        if (point_visited_test(bitmap, i)) {
+            CELL_SET_MINE(board->cells[i]);
+            board->mine_count++;
+        }
+    }
+
+    board_compute_neighbor_counts(board);
+}
+
+uint8_t board_transform_count(uint8_t width, uint8_t height) {
+    return width == height ? MineSweeperTransformCount : MineSweeperTransformTranspose;
+}
+
+MineSweeperStartCorner board_transform_corner(MineSweeperTransform transform) {
+    furi_assert(transform < MineSweeperTransformCount);
+
+    return (MineSweeperStartCorner)(transform & 0x03u);
+}
+
+MineSweeperTransform board_pick_transform(
+    uint8_t width,
+    uint8_t height,
+    uint8_t start_corner,
+    uint8_t used_mask) {
+    MineSweeperTransform candidates[MineSweeperTransformCount];
+    uint8_t count = 0;
+
+    const uint8_t total = board_transform_count(width, height);
+    for (uint8_t t = 0; t < total; ++t) {
+        if (used_mask & (1u << t)) continue;
+        if (start_corner != MineSweeperStartCornerAny &&
+            board_transform_corner((MineSweeperTransform)t) != start_corner) {
+            continue;
+        }
+        candidates[count++] = (MineSweeperTransform)t;
+    }
+
+    if (count == 0) {
+        return MineSweeperTransformCount;
+    }
+
+    return candidates[random_uniform_u16(count)];
+}
+
+// Where tile (x, y) of the canonical board lands. Transforms that swap rows and
+// columns are only used on square boards, so width and height are interchangeable there.
+static void board_transform_point(
+    uint8_t width,
+    uint8_t height,
+    MineSweeperTransform transform,
+    uint8_t* x,
+    uint8_t* y) {
+    const uint8_t src_x = *x;
+    const uint8_t src_y = *y;
+    const uint8_t mirror_x = (uint8_t)(width - 1u - src_x);
+    const uint8_t mirror_y = (uint8_t)(height - 1u - src_y);
+
+    switch (transform) {
+    case MineSweeperTransformFlipX:
+        *x = mirror_x;
+        break;
+    case MineSweeperTransformFlipY:
+        *y = mirror_y;
+        break;
+    case MineSweeperTransformRotate180:
+        *x = mirror_x;
+        *y = mirror_y;
+        break;
+    case MineSweeperTransformTranspose:
+        *x = src_y;
+        *y = src_x;
+        break;
+    case MineSweeperTransformRotate90:
+        *x = mirror_y;
+        *y = src_x;
+        break;
+    case MineSweeperTransformRotate270:
+        *x = src_y;
+        *y = mirror_x;
+        break;
+    case MineSweeperTransformAntiTranspose:
+        *x = mirror_y;
+        *y = mirror_x;
+        break;
+    case MineSweeperTransformIdentity:
+    default:
+        break;
+    }
+}
+
+void board_transform_mines(
+    const uint8_t* src,
+    uint8_t width,
+    uint8_t height,
+    MineSweeperTransform transform,
+    uint8_t* dst) {
+    furi_assert(src);
+    furi_assert(dst);
+    furi_assert(src != dst);
+    furi_assert(transform < board_transform_count(width, height));
+
+    const uint16_t total = (uint16_t)width * height;
+    point_visited_clear(dst, total);
+
     for (uint16_t i = 0; i < total; ++i) {
-        board->cells[i] &= (uint8_t)~(CELL_REVEALED_MASK | CELL_FLAG_MASK);
+        if (!point_visited_test(src, i)) continue;
+
+        uint8_t x = (uint8_t)(i % width);
+        uint8_t y = (uint8_t)(i / width);
+        board_transform_point(width, height, transform, &x, &y);
+        point_visited_set(dst, (uint16_t)y * width + x);
     }
 }
 
-static void board_generate_candidate(MineSweeperBoard* board, uint16_t mine_count) {
+void board_generate_candidate(MineSweeperBoard* board, uint16_t mine_count) {
     furi_assert(board);
 
     board_clear(board);
@@ -110,7 +256,10 @@ static bool config_is_valid(const MineSweeperConfig* config) {
     if (!config) return false;
 
     return config->width > 0 && config->height > 0 && config->width <= BOARD_MAX_WIDTH &&
-           config->height <= BOARD_MAX_HEIGHT && config->difficulty <= 2;
+           config->height <= BOARD_MAX_HEIGHT &&
+           config->difficulty < MINESWEEPER_DIFFICULTY_COUNT &&
+           config->start_corner < MineSweeperStartCornerCount &&
+           (config->bbbv_max == 0 || config->bbbv_min <= config->bbbv_max);
 }
 
 static bool
@@ -122,6 +271,8 @@ static bool
         return false;
     }
 
+    if (runtime->start_corner >= MineSweeperStartCornerAny) return false;
+
     uint16_t total = (uint16_t)board->width * board->height;
     if (board->mine_count > total) return false;
     uint16_t safe_total = total - board->mine_count;
@@ -214,6 +365,68 @@ void board_compute_neighbor_counts(MineSweeperBoard* board) {
     }
 }
 
+static uint16_t board_opening_root(uint16_t* parent, uint16_t i) {
+    while (parent[i] != i) {
+        parent[i] = parent[parent[i]];
+        i = parent[i];
+    }
+    return i;
+}
+
+uint16_t board_compute_3bv(const MineSweeperBoard* board, uint16_t* scratch) {
+    furi_assert(board);
+    furi_assert(scratch);
+
+    // Openings are unioned in raster order: a zero only ever links to zeros
+    // already seen (west and the row above), so every opening costs one new
+    // root and every successful union removes one.
+    uint16_t zeros = 0;
+    uint16_t merges = 0;
+    uint16_t isolated = 0;
+
+    for (uint8_t y = 0; y < board->height; ++y) {
+        for (uint8_t x = 0; x < board->width; ++x) {
+            const uint16_t i = board_index(board, x, y);
+            const MineSweeperCell cell = board->cells[i];
+
+            if (CELL_IS_MINE(cell)) continue;
+
+            const bool is_zero = CELL_GET_NEIGHBORS(cell) == 0;
+            bool touches_zero = false;
+
+            if (is_zero) {
+                scratch[i] = i;
+                zeros++;
+            }
+
+            for (uint8_t n = 0; n < 8; ++n) {
+                const int8_t nx = x + neighbor_offsets[n][0];
+                const int8_t ny = y + neighbor_offsets[n][1];
+                if (!board_in_bounds(board, nx, ny)) continue;
+
+                const uint16_t ni = board_index(board, nx, ny);
+                const MineSweeperCell neighbor = board->cells[ni];
+                if (CELL_IS_MINE(neighbor) || CELL_GET_NEIGHBORS(neighbor) != 0) continue;
+
+                touches_zero = true;
+                if (!is_zero || ni > i) continue;
+
+                const uint16_t a = board_opening_root(scratch, i);
+                const uint16_t b = board_opening_root(scratch, ni);
+                if (a != b) {
+                    scratch[a] = b;
+                    merges++;
+                }
+            }
+
+            // A number next to an opening is cleared with it; any other takes its own click.
+            if (!is_zero && !touches_zero) isolated++;
+        }
+    }
+
+    return (uint16_t)(zeros - merges + isolated);
+}
+
 bool board_reveal_cell(MineSweeperBoard* board, uint8_t x, uint8_t y) {
     furi_assert(board);
     uint16_t i = board_index(board, x, y);
@@ -290,27 +503,145 @@ void board_toggle_flag(MineSweeperBoard* board, uint8_t x, uint8_t y) {
         CELL_SET_FLAGGED(board->cells[i]);
 }
 
-static uint16_t minesweeper_engine_compute_mine_count(const MineSweeperConfig* config) {
+static float minesweeper_engine_density(const MineSweeperConfig* config) {
+    furi_assert(config);
+
+    const uint8_t difficulty = config->difficulty >= MINESWEEPER_DIFFICULTY_COUNT ?
+                                   MINESWEEPER_DIFFICULTY_COUNT - 1 :
+                                   config->difficulty;
+    return difficulty_multiplier[difficulty];
+}
+
+uint16_t minesweeper_engine_mine_count(const MineSweeperConfig* config) {
     furi_assert(config);
 
     const uint16_t total_cells = (uint16_t)config->width * config->height;
+    return (uint16_t)(total_cells * minesweeper_engine_density(config));
+}
+
+static bool minesweeper_engine_has_clicks_band(const MineSweeperConfig* config) {
+    return config->bbbv_min != 0 || config->bbbv_max != 0;
+}
+
+// Mean attempts until a playable board, or 0 if the atlas has no estimate.
+static float minesweeper_engine_expected_attempts(
+    const MineSweeperConfig* config,
+    MineSweeperStrategy strategy) {
+    furi_assert(config);
 
-    const uint8_t difficulty = config->difficulty >= 3 ? 2 : config->difficulty;
-    return (uint16_t)(total_cells * difficulty_multiplier[difficulty]);
+    float accept = 1.0f;
+
+    if (config->ensure_solvable) {
+        MineSweeperAtlasEstimate estimate;
+        minesweeper_atlas_estimate(config->width, config->height, config->difficulty, &estimate);
+        accept = estimate.accept[strategy];
+    }
+
+    // Each 3BV band holds about a third of the boards.
+    if (minesweeper_engine_has_clicks_band(config)) {
+        accept /= 3.0f;
+    }
+
+    return accept > 0.0f ? 1.0f / accept : 0.0f;
+}
+
+// Checks a laid out board against the config's 3BV range, using scratch for the openings.
+static bool minesweeper_engine_in_clicks_band(
+    const MineSweeperBoard* board,
+    const MineSweeperConfig* config,
+    uint16_t* scratch) {
+    if (!minesweeper_engine_has_clicks_band(config)) {
+        return true;
+    }
+
+    const uint16_t bbbv = board_compute_3bv(board, scratch);
+    return bbbv >= config->bbbv_min && (config->bbbv_max == 0 || bbbv <= config->bbbv_max);
 }
 
-static void minesweeper_engine_prepare_runtime(MineSweeperState* game_state) {
+// Produces one candidate board and reports whether it can be played: inside the
+// 3BV range and, if required, known to be solvable from 0,0.
+static bool minesweeper_engine_generate_attempt(
+    MineSweeperBoard* board,
+    const MineSweeperConfig* config,
+    MineSweeperStrategy strategy,
+    uint16_t mine_count,
+    uint16_t* scratch) {
+    furi_assert(board);
+    furi_assert(config);
+    furi_assert(scratch);
+
+    const MineSweeperStrategyOps* ops = minesweeper_strategy_ops(strategy);
+    uint16_t cleared = 0;
+    const bool placed_solvable = ops->place(board, mine_count, &cleared);
+
+    if (ops->self_verifying) {
+        return placed_solvable && minesweeper_engine_in_clicks_band(board, config, scratch);
+    }
+
+    // Out-of-band boards are dropped before they ever reach the solver.
+    if (!minesweeper_engine_in_clicks_band(board, config, scratch)) {
+        return false;
+    }
+
+    if (!config->ensure_solvable) {
+        return true;
+    }
+
+    return check_board_with_solver(board);
+}
+
+static void minesweeper_engine_prepare_runtime(
+    MineSweeperState* game_state,
+    MineSweeperStartCorner start_corner) {
     furi_assert(game_state);
+    furi_assert(start_corner < MineSweeperStartCornerAny);
 
-    const uint16_t total_cells = (uint16_t)game_state->board.width * game_state->board.height;
+    const uint8_t width = game_state->board.width;
+    const uint8_t height = game_state->board.height;
+    const uint16_t total_cells = (uint16_t)width * height;
     const uint16_t mine_count = game_state->board.mine_count;
 
     game_state->rt.tiles_left = total_cells - mine_count;
     game_state->rt.flags_left = mine_count;
     game_state->rt.mines_left = mine_count;
     game_state->rt.phase = MineSweeperPhasePlaying;
-    game_state->rt.cursor_col = 0;
-    game_state->rt.cursor_row = 0;
+    game_state->rt.start_corner = start_corner;
+    // The cursor starts on the tile the board is solvable from.
+    game_state->rt.cursor_col = (start_corner == MineSweeperStartCornerTopRight ||
+                                 start_corner == MineSweeperStartCornerBottomRight) ?
+                                    width - 1u :
+                                    0u;
+    game_state->rt.cursor_row = (start_corner == MineSweeperStartCornerBottomLeft ||
+                                 start_corner == MineSweeperStartCornerBottomRight) ?
+                                    height - 1u :
+                                    0u;
+}
+
+// Turns a freshly generated canonical board to a transform picked for this config.
+static MineSweeperStartCorner minesweeper_engine_orient_board(
+    MineSweeperBoard* board,
+    const MineSweeperConfig* config) {
+    const MineSweeperTransform transform =
+        board_pick_transform(board->width, board->height, config->start_corner, 0);
+    furi_check(transform < MineSweeperTransformCount);
+
+    if (transform != MineSweeperTransformIdentity) {
+        uint8_t canonical[BOARD_MINE_BITMAP_BYTES];
+        uint8_t oriented[BOARD_MINE_BITMAP_BYTES];
+        board_pack_mines(board, canonical);
+        board_transform_mines(canonical, board->width, board->height, transform, oriented);
+        board_unpack_mines(board, board->width, board->height, oriented);
+    }
+
+    return board_transform_corner(transform);
+}
+
+// Leaves InProgress exactly once, so a cancel racing a finishing attempt has a single winner.
+static void minesweeper_engine_generation_transition(
+    MineSweeperGenerationJob* job,
+    MineSweeperGenerationStatus next) {
+    MineSweeperGenerationStatus expected = MineSweeperGenerationStatusInProgress;
+    atomic_compare_exchange_strong(&job->status, &expected, next);
 }
 
 MineSweeperResult minesweeper_engine_generation_begin(
@@ -322,52 +653,254 @@ MineSweeperResult minesweeper_engine_generation_begin(
 
     memset(job, 0, sizeof(*job));
     job->config = *config;
-    job->status = MineSweeperGenerationStatusInProgress;
+    job->strategy = minesweeper_strategy_pick(config);
+    job->expected_attempts =
+        minesweeper_engine_expected_attempts(config, (MineSweeperStrategy)job->strategy);
     job->start_tick = furi_get_tick();
+    atomic_store(&job->attempts_total, 0);
+    atomic_store(&job->attempt_cost_us_q4, 0);
+    atomic_store(&job->cancel_requested, false);
+    atomic_store(&job->has_forced_board, false);
+    atomic_store(&job->status, MineSweeperGenerationStatusInProgress);
 
     return MineSweeperResultChanged;
 }
 
+// Records a finished attempt and leaves InProgress once a usable board turned up.
+static void minesweeper_engine_generation_conclude(
+    MineSweeperGenerationJob* job,
+    bool is_solvable,
+    uint16_t cleared) {
+    // Candidates stay canonical; they are only turned when a game is loaded from them.
+    minesweeper_engine_prepare_runtime(&job->latest_candidate, MineSweeperStartCornerTopLeft);
+
+    job->has_latest_candidate = true;
+    atomic_store(&job->has_forced_board, true);
+    job->latest_candidate_is_solved = is_solvable;
+    atomic_fetch_add(&job->attempts_total, 1);
+
+    if (!is_solvable && (!job->has_best_candidate || cleared > job->best_candidate_cleared)) {
+        board_pack_mines(&job->latest_candidate.board, job->best_candidate_mines);
+        job->best_candidate_cleared = cleared;
+        job->has_best_candidate = true;
+    }
+
+    if (!job->config.ensure_solvable || is_solvable) {
+        minesweeper_engine_generation_transition(job, MineSweeperGenerationStatusReady);
+    }
+}
+
+// Lays out a new candidate. Boards from self-verifying strategies conclude right
+// away; the rest leave their verification pending for minesweeper_engine_solver_step.
+static void minesweeper_engine_generation_start_attempt(MineSweeperGenerationJob* job) {
+    const uint16_t mine_count = minesweeper_engine_mine_count(&job->config);
+
+    memset(&job->latest_candidate, 0, sizeof(job->latest_candidate));
+    job->latest_candidate.config = job->config;
+    job->latest_candidate_is_solved = false;
+    board_init(&job->latest_candidate.board, job->config.width, job->config.height);
+
+    const MineSweeperStrategyOps* ops =
+        minesweeper_strategy_ops((MineSweeperStrategy)job->strategy);
+    uint16_t cleared = 0;
+    const bool placed_solvable = ops->place(&job->latest_candidate.board, mine_count, &cleared);
+
+    // The solver's edge queue is idle between attempts, so it doubles as 3BV scratch.
+    if (!minesweeper_engine_in_clicks_band(
+           &job->latest_candidate.board, &job->config, job->solver.edges)) {
+        // Rejected before the solver; not worth keeping even for a forced start.
+        atomic_fetch_add(&job->attempts_total, 1);
+        return;
+    }
+
+    if (ops->self_verifying) {
+        minesweeper_engine_generation_conclude(job, placed_solvable, cleared);
+        return;
+    }
+
+    if (!job->config.ensure_solvable) {
+        minesweeper_engine_generation_conclude(job, false, 0);
+        return;
+    }
+
+    // Hopeless at a glance; the solver would have got stuck on it too.
+    if (solver_prefilter(&job->latest_candidate.board) != MineSweeperPrefilterPass) {
+        minesweeper_engine_generation_conclude(job, false, 0);
+        return;
+    }
+
+    solver_begin(&job->solver, &job->latest_candidate.board);
+    job->verification_pending = true;
+    // A forced start abandons the verification and takes the board as it is.
+    atomic_store(&job->has_forced_board, true);
+}
+
+// Drops a half-verified candidate, scoring it on what the solver got through so far.
+static void minesweeper_engine_generation_abandon_attempt(MineSweeperGenerationJob* job) {
+    if (!job->verification_pending) {
+        return;
+    }
+
+    job->verification_pending = false;
+    const uint16_t cleared = solver_revealed_count(&job->solver, &job->latest_candidate.board);
+    minesweeper_engine_generation_conclude(job, false, cleared);
+}
+
+MineSweeperSolverPhase
+    minesweeper_engine_solver_step(MineSweeperGenerationJob* job, uint32_t max_work_units) {
+    furi_assert(job);
+
+    if (!job->verification_pending) {
+        return MineSweeperSolverPhaseIdle;
+    }
+
+    const MineSweeperSolverPhase phase =
+        solver_step(&job->solver, &job->latest_candidate.board, max_work_units);
+
+    if (phase != MineSweeperSolverPhaseRunning) {
+        job->verification_pending = false;
+        const uint16_t cleared =
+            solver_revealed_count(&job->solver, &job->latest_candidate.board);
+        minesweeper_engine_generation_conclude(
+            job, phase == MineSweeperSolverPhaseSolved, cleared);
+    }
+
+    return phase;
+}
+
 MineSweeperGenerationStatus
     minesweeper_engine_generation_step(MineSweeperGenerationJob* job, uint16_t attempt_budget) {
     if (!job) {
         return MineSweeperGenerationStatusFailed;
     }
 
-    if (job->status != MineSweeperGenerationStatusInProgress || attempt_budget == 0) {
-        return job->status;
+    if (atomic_load(&job->status) != MineSweeperGenerationStatusInProgress ||
+        attempt_budget == 0) {
+        return atomic_load(&job->status);
+    }
+
+    uint16_t attempts_done = 0;
+
+    while (attempts_done < attempt_budget &&
+           atomic_load(&job->status) == MineSweeperGenerationStatusInProgress) {
+        // Cooperative cancellation point, also between solver chunks.
+        if (atomic_load(&job->cancel_requested)) {
+            minesweeper_engine_generation_transition(job, MineSweeperGenerationStatusCancelled);
+            break;
+        }
+
+        if (!job->verification_pending) {
+            minesweeper_engine_generation_start_attempt(job);
+        } else {
+            minesweeper_engine_solver_step(job, MINESWEEPER_SOLVER_CHUNK_UNITS);
+        }
+
+        if (!job->verification_pending) {
+            attempts_done++;
+        }
     }
 
-    const uint16_t mine_count = minesweeper_engine_compute_mine_count(&job->config);
+    return atomic_load(&job->status);
+}
 
-    for (uint16_t i = 0; i < attempt_budget; ++i) {
-        memset(&job->latest_candidate, 0, sizeof(job->latest_candidate));
-        job->latest_candidate.config = job->config;
-        job->latest_candidate_is_solved = false;
+// A zero-length cortex timer starts at the current DWT cycle count.
+static inline uint32_t generation_cycles_now(void) {
+    return furi_hal_cortex_timer_get(0).start;
+}
+
+static inline uint32_t generation_cycles_to_us(uint32_t cycles) {
+    return cycles / furi_hal_cortex_instructions_per_microsecond();
+}
+
+static void minesweeper_engine_generation_record_cost(
+    MineSweeperGenerationJob* job,
+    uint32_t attempt_cycles) {
+    // EMA with alpha = 1/8, kept in Q4 so short attempts don't round away.
+    const uint32_t sample_q4 = generation_cycles_to_us(attempt_cycles) << 4;
+    const uint32_t cost_q4 = atomic_load(&job->attempt_cost_us_q4);
+    if (cost_q4 == 0) {
+        atomic_store(&job->attempt_cost_us_q4, sample_q4 ? sample_q4 : 1u);
+    } else {
+        atomic_store(&job->attempt_cost_us_q4, cost_q4 - (cost_q4 >> 3) + (sample_q4 >> 3));
+    }
+}
 
-        board_init(&job->latest_candidate.board, job->config.width, job->config.height);
-        board_generate_candidate(&job->latest_candidate.board, mine_count);
-        minesweeper_engine_prepare_runtime(&job->latest_candidate);
+MineSweeperGenerationStatus
+    minesweeper_engine_generation_step_timed(MineSweeperGenerationJob* job, uint32_t budget_us) {
+    if (!job) {
+        return MineSweeperGenerationStatusFailed;
+    }
 
-        job->has_latest_candidate = true;
-        job->attempts_total++;
+    MineSweeperGenerationStatus status = atomic_load(&job->status);
+    const uint32_t slice_start = generation_cycles_now();
+    bool did_work = false;
 
-        if (!job->config.ensure_solvable) {
-            job->status = MineSweeperGenerationStatusReady;
+    while (status == MineSweeperGenerationStatusInProgress) {
+        if (atomic_load(&job->cancel_requested)) {
+            minesweeper_engine_generation_transition(job, MineSweeperGenerationStatusCancelled);
             break;
         }
 
-        const bool is_solvable = check_board_with_solver(&job->latest_candidate.board);
-        board_clear_solver_marks(&job->latest_candidate.board);
-        job->latest_candidate_is_solved = is_solvable;
+        const uint32_t elapsed_us = generation_cycles_to_us(generation_cycles_now() - slice_start);
 
-        if (is_solvable) {
-            job->status = MineSweeperGenerationStatusReady;
+        if (did_work && elapsed_us >= budget_us) {
             break;
         }
+
+        // Self-verifying attempts can't be split, so don't start one expected to overrun.
+        if (did_work && !job->verification_pending &&
+            minesweeper_strategy_ops((MineSweeperStrategy)job->strategy)->self_verifying &&
+            elapsed_us + (atomic_load(&job->attempt_cost_us_q4) >> 4) > budget_us) {
+            break;
+        }
+
+        const uint32_t chunk_start = generation_cycles_now();
+
+        if (!job->verification_pending) {
+            job->attempt_cycles = 0;
+            minesweeper_engine_generation_start_attempt(job);
+        } else {
+            minesweeper_engine_solver_step(job, MINESWEEPER_SOLVER_CHUNK_UNITS);
+        }
+
+        job->attempt_cycles += generation_cycles_now() - chunk_start;
+        did_work = true;
+
+        if (!job->verification_pending) {
+            minesweeper_engine_generation_record_cost(job, job->attempt_cycles);
+        }
+
+        status = atomic_load(&job->status);
+    }
+
+    return status;
+}
+
+uint32_t minesweeper_engine_generation_eta_ms(const MineSweeperGenerationJob* job) {
+    if (!job || job->expected_attempts <= 0.0f) {
+        return UINT32_MAX;
+    }
+
+    const uint32_t cost_q4 = atomic_load(&job->attempt_cost_us_q4);
+    if (cost_q4 == 0) {
+        return UINT32_MAX;
+    }
+
+    // Attempts are independent, so the wait ahead doesn't shrink with the ones
+    // already made; count down from the expected total instead and hold at 0.
+    const float total_ms = job->expected_attempts * (cost_q4 / 16.0f) / 1000.0f;
+    const uint32_t elapsed_ms = furi_get_tick() - job->start_tick;
+
+    if (total_ms >= (float)UINT32_MAX) {
+        return UINT32_MAX - 1u;
     }
 
-    return job->status;
+    const uint32_t total = (uint32_t)total_ms;
+    return total > elapsed_ms ? total - elapsed_ms : 0u;
+}
+
+bool minesweeper_engine_generation_has_forced_board(const MineSweeperGenerationJob* job) {
+    return job && atomic_load(&job->has_forced_board);
 }
 
 MineSweeperGenerationStatus
@@ -376,23 +909,26 @@ MineSweeperGenerationStatus
         return MineSweeperGenerationStatusFailed;
     }
 
-    return job->status;
+    return atomic_load(&job->status);
 }
 
-MineSweeperResult minesweeper_engine_generation_finish(
+MineSweeperResult minesweeper_engine_generation_finish_mines(
     MineSweeperGenerationJob* job,
-    MineSweeperState* out_state,
+    uint8_t* mines_out,
     bool allow_unsolved_fallback) {
-    if (!job || !out_state) {
+    if (!job || !mines_out) {
         return MineSweeperResultInvalid;
     }
 
-    if (job->status == MineSweeperGenerationStatusCancelled ||
-        job->status == MineSweeperGenerationStatusFailed ||
-        job->status == MineSweeperGenerationStatusIdle) {
+    const MineSweeperGenerationStatus status = atomic_load(&job->status);
+    if (status == MineSweeperGenerationStatusCancelled ||
+        status == MineSweeperGenerationStatusFailed || status == MineSweeperGenerationStatusIdle) {
         return MineSweeperResultInvalid;
     }
 
+    // A board still being verified when the player forces a start counts as unsolved.
+    minesweeper_engine_generation_abandon_attempt(job);
+
     if (!job->has_latest_candidate) {
         return MineSweeperResultInvalid;
     }
@@ -403,41 +939,210 @@ MineSweeperResult minesweeper_engine_generation_finish(
         return MineSweeperResultInvalid;
     }
 
-    *out_state = job->latest_candidate;
-    minesweeper_engine_prepare_runtime(out_state);
-    out_state->rt.start_tick = furi_get_tick();
-    job->status = MineSweeperGenerationStatusReady;
+    // A forced start gets the unsolved board the solver got furthest on.
+    if (!job->latest_candidate_is_solved && job->config.ensure_solvable &&
+        job->has_best_candidate) {
+        memcpy(mines_out, job->best_candidate_mines, BOARD_MINE_BITMAP_BYTES);
+    } else {
+        board_pack_mines(&job->latest_candidate.board, mines_out);
+    }
+
+    atomic_store(&job->status, MineSweeperGenerationStatusReady);
 
     return MineSweeperResultChanged;
 }
 
+MineSweeperResult minesweeper_engine_generation_finish(
+    MineSweeperGenerationJob* job,
+    MineSweeperState* out_state,
+    bool allow_unsolved_fallback) {
+    if (!job || !out_state) {
+        return MineSweeperResultInvalid;
+    }
+
+    uint8_t mines[BOARD_MINE_BITMAP_BYTES];
+    if (minesweeper_engine_generation_finish_mines(job, mines, allow_unsolved_fallback) !=
+        MineSweeperResultChanged) {
+        return MineSweeperResultInvalid;
+    }
+
+    const MineSweeperTransform transform =
+        board_pick_transform(job->config.width, job->config.height, job->config.start_corner, 0);
+    return minesweeper_engine_load_board(out_state, &job->config, mines, transform);
+}
+
 void minesweeper_engine_generation_cancel(MineSweeperGenerationJob* job) {
     if (!job) {
         return;
     }
 
-    job->status = MineSweeperGenerationStatusCancelled;
+    // Whoever is stepping the job notices the flag between attempts; an idle job
+    // is cancelled right away.
+    atomic_store(&job->cancel_requested, true);
+    minesweeper_engine_generation_transition(job, MineSweeperGenerationStatusCancelled);
+}
+
+void minesweeper_engine_set_clicks_band(MineSweeperConfig* config, uint8_t band) {
+    furi_assert(config);
+
+    config->bbbv_min = 0;
+    config->bbbv_max = 0;
+
+    if (band == MineSweeperClicksAny || band >= MineSweeperClicksCount) {
+        return;
+    }
+
+    const uint8_t difficulty = config->difficulty >= MINESWEEPER_DIFFICULTY_COUNT ?
+                                   MINESWEEPER_DIFFICULTY_COUNT - 1 :
+                                   config->difficulty;
+    const uint16_t tiles = (uint16_t)config->width * config->height;
+    const float mean = tiles * bbbv_mean_per_tile_q10[difficulty] / 1024.0f;
+    const float sd = sqrtf(tiles) * bbbv_sd_per_root_tile_q10[difficulty] / 1024.0f;
+    const float low = mean - BBBV_BAND_EDGE_SD * sd;
+    const float high = mean + BBBV_BAND_EDGE_SD * sd;
+
+    // The bands share no boards: Fewer ends just below Typical, More starts just above it.
+    const uint16_t low_edge = low < 1.0f ? 1u : (uint16_t)low;
+    const uint16_t high_edge = (uint16_t)high + 1u;
+
+    switch (band) {
+    case MineSweeperClicksFewer:
+        config->bbbv_min = 1;
+        config->bbbv_max = low_edge;
+        break;
+    case MineSweeperClicksTypical:
+        config->bbbv_min = low_edge + 1u;
+        config->bbbv_max = high_edge - 1u;
+        break;
+    case MineSweeperClicksMore:
+    default:
+        config->bbbv_min = high_edge;
+        break;
+    }
+
+    if (config->bbbv_max != 0 && config->bbbv_max < config->bbbv_min) {
+        config->bbbv_max = config->bbbv_min;
+    }
 }
 
 void minesweeper_engine_new_game(MineSweeperState* game_state) {
     furi_assert(game_state);
 
-    const uint16_t number_mines = minesweeper_engine_compute_mine_count(&game_state->config);
-    bool is_solvable = false;
+    const uint16_t number_mines = minesweeper_engine_mine_count(&game_state->config);
+    const MineSweeperStrategy strategy = minesweeper_strategy_pick(&game_state->config);
 
-    do {
-        board_generate_candidate(&game_state->board, number_mines);
+    // Too big for the GUI thread's stack.
+    uint16_t* scratch = malloc(sizeof(uint16_t) * BOARD_MAX_TILES);
+    furi_check(scratch);
 
-        if (!game_state->config.ensure_solvable) {
-            break;
-        }
+    while (!minesweeper_engine_generate_attempt(
+        &game_state->board, &game_state->config, strategy, number_mines, scratch)) {
+    }
+
+    free(scratch);
+
+    const MineSweeperStartCorner start_corner =
+        minesweeper_engine_orient_board(&game_state->board, &game_state->config);
+    minesweeper_engine_prepare_runtime(game_state, start_corner);
+    game_state->rt.start_tick = furi_get_tick();
+}
+
+MineSweeperResult minesweeper_engine_load_board(
+    MineSweeperState* game_state,
+    const MineSweeperConfig* config,
+    const uint8_t* mine_bitmap,
+    MineSweeperTransform transform) {
+    furi_assert(game_state);
+    furi_assert(mine_bitmap);
 
-        is_solvable = check_board_with_solver(&game_state->board);
-        board_clear_solver_marks(&game_state->board);
-    } while (!is_solvable);
+    if (!config_is_valid(config) ||
+        transform >= board_transform_count(config->width, config->height)) {
+        return MineSweeperResultInvalid;
+    }
 
-    minesweeper_engine_prepare_runtime(game_state);
+    uint8_t oriented[BOARD_MINE_BITMAP_BYTES];
+    board_transform_mines(mine_bitmap, config->width, config->height, transform, oriented);
+
+    game_state->config = *config;
+    board_unpack_mines(&game_state->board, config->width, config->height, oriented);
+    minesweeper_engine_prepare_runtime(game_state, board_transform_corner(transform));
     game_state->rt.start_tick = furi_get_tick();
+
+    return MineSweeperResultChanged;
+}
+
+MineSweeperResult minesweeper_engine_start_placeholder(
+    MineSweeperState* game_state,
+    const MineSweeperConfig* config) {
+    furi_assert(game_state);
+
+    if (!config_is_valid(config)) {
+        return MineSweeperResultInvalid;
+    }
+
+    game_state->config = *config;
+    board_init(&game_state->board, config->width, config->height);
+    // No mine bits yet, but the HUD and flag budget already use the real count.
+    game_state->board.mine_count = minesweeper_engine_mine_count(config);
+    const MineSweeperStartCorner start_corner =
+        config->start_corner == MineSweeperStartCornerAny ?
+            (MineSweeperStartCorner)random_uniform_u16(MineSweeperStartCornerAny) :
+            (MineSweeperStartCorner)config->start_corner;
+    minesweeper_engine_prepare_runtime(game_state, start_corner);
+    game_state->rt.start_tick = furi_get_tick();
+
+    return MineSweeperResultChanged;
+}
+
+MineSweeperResult
+    minesweeper_engine_adopt_mines(MineSweeperState* game_state, const uint8_t* mine_bitmap) {
+    furi_assert(game_state);
+    furi_assert(mine_bitmap);
+
+    MineSweeperBoard* board = &game_state->board;
+    const uint16_t total = (uint16_t)board->width * board->height;
+
+    if (game_state->rt.phase != MineSweeperPhasePlaying) {
+        return MineSweeperResultInvalid;
+    }
+
+    uint8_t flags[BOARD_MINE_BITMAP_BYTES];
+    point_visited_clear(flags, total);
+
+    for (uint16_t i = 0; i < total; ++i) {
+        if (CELL_IS_REVEALED(board->cells[i])) {
+            return MineSweeperResultInvalid;
+        }
+        if (CELL_IS_FLAGGED(board->cells[i])) {
+            point_visited_set(flags, i);
+        }
+    }
+
+    // Every corner has at least the one transform that lands the start tile there.
+    const MineSweeperTransform transform =
+        board_pick_transform(board->width, board->height, game_state->rt.start_corner, 0);
+    furi_check(transform < MineSweeperTransformCount);
+
+    uint8_t oriented[BOARD_MINE_BITMAP_BYTES];
+    board_transform_mines(mine_bitmap, board->width, board->height, transform, oriented);
+    board_unpack_mines(board, board->width, board->height, oriented);
+
+    game_state->rt.tiles_left = total - board->mine_count;
+    game_state->rt.flags_left = board->mine_count;
+    game_state->rt.mines_left = board->mine_count;
+
+    // Keep the player's flags, dropping any beyond the real mine count.
+    for (uint16_t i = 0; i < total && game_state->rt.flags_left > 0; ++i) {
+        if (!point_visited_test(flags, i)) continue;
+
+        CELL_SET_FLAGGED(board->cells[i]);
+        game_state->rt.flags_left--;
+        if (CELL_IS_MINE(board->cells[i])) {
+            game_state->rt.mines_left--;
+        }
+    }
+
+    return MineSweeperResultChanged;
 }
 
 MineSweeperResult minesweeper_engine_reveal(MineSweeperState* game_state, uint16_t x, uint16_t y) {
@@ -620,6 +1325,23 @@ MineSweeperResult
     return MineSweeperResultChanged;
 }
 
+MineSweeperResult
+    minesweeper_engine_set_cursor(MineSweeperState* game_state, uint8_t x, uint8_t y) {
+    furi_assert(game_state);
+
+    if (x >= game_state->board.width || y >= game_state->board.height) {
+        return MineSweeperResultInvalid;
+    }
+
+    if (game_state->rt.cursor_col == x && game_state->rt.cursor_row == y) {
+        return MineSweeperResultNoop;
+    }
+
+    game_state->rt.cursor_col = x;
+    game_state->rt.cursor_row = y;
+    return MineSweeperResultChanged;
+}
+
 MineSweeperResult minesweeper_engine_move_to_closest_tile(MineSweeperState* game_state) {
     furi_assert(game_state);
 
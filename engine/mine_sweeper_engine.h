@@ -3,6 +3,7 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stdatomic.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -64,6 +65,53 @@ typedef uint8_t MineSweeperCell;
 #define BOARD_MAX_HEIGHT (32u)
 #define BOARD_MAX_TILES  (BOARD_MAX_WIDTH * BOARD_MAX_HEIGHT)
 
+/* Compact board form: one bit per tile, set for mines, row-major */
+#define BOARD_MINE_BITMAP_BYTES ((BOARD_MAX_TILES + 7u) / 8u)
+
+/* Difficulty levels (Easy, Medium, Hard, Expert) */
+#define MINESWEEPER_DIFFICULTY_COUNT (4u)
+
+/* Click-count bands relative to a typical board of the same size and density,
+ * each holding about a third of random boards. */
+typedef enum {
+    MineSweeperClicksAny = 0,
+    MineSweeperClicksFewer,
+    MineSweeperClicksTypical,
+    MineSweeperClicksMore,
+    MineSweeperClicksCount,
+} MineSweeperClicksBand;
+
+/* Corner the game starts from. Any lets each game pick one. */
+typedef enum {
+    MineSweeperStartCornerTopLeft = 0,
+    MineSweeperStartCornerTopRight,
+    MineSweeperStartCornerBottomLeft,
+    MineSweeperStartCornerBottomRight,
+    MineSweeperStartCornerAny,
+    MineSweeperStartCornerCount,
+} MineSweeperStartCorner;
+
+/** Board symmetries.
+  *
+  * Boards are generated, verified, pooled and stored in one canonical
+  * orientation, solvable from the top left tile. A transform maps that tile to
+  * another corner and keeps the board solvable from there, so one verified
+  * board gives 4 distinct games on a rectangle and 8 on a square.
+  * transform % 4 is the corner the top left tile ends up in; the last four
+  * swap rows and columns and only apply to square boards.
+  */
+typedef enum {
+    MineSweeperTransformIdentity = 0,
+    MineSweeperTransformFlipX,
+    MineSweeperTransformFlipY,
+    MineSweeperTransformRotate180,
+    MineSweeperTransformTranspose,
+    MineSweeperTransformRotate90,
+    MineSweeperTransformRotate270,
+    MineSweeperTransformAntiTranspose,
+    MineSweeperTransformCount,
+} MineSweeperTransform;
+
 /* ---- Queries ---- */
 #define CELL_IS_MINE(c)       (((c) & CELL_MINE_MASK) != 0u)
 #define CELL_IS_REVEALED(c)   (((c) & CELL_REVEALED_MASK) != 0u)
@@ -100,6 +148,10 @@ typedef struct {
     uint8_t difficulty;
     bool ensure_solvable;
     bool wrap_enabled;
+    uint8_t start_corner; // MineSweeperStartCorner
+    // Accepted 3BV range, inclusive; bbbv_max == 0 means no upper bound
+    uint16_t bbbv_min;
+    uint16_t bbbv_max;
 } MineSweeperConfig;
 
 typedef struct {
@@ -110,6 +162,7 @@ typedef struct {
     uint16_t tiles_left;
     uint32_t start_tick;
     MineSweeperPhase phase;
+    uint8_t start_corner; // where this game started, never Any
 } MineSweeperRuntime;
 
 typedef struct {
@@ -118,6 +171,65 @@ typedef struct {
     MineSweeperRuntime rt;
 } MineSweeperState;
 
+typedef enum {
+    MineSweeperSolverPhaseIdle = 0,
+    MineSweeperSolverPhaseRunning,
+    MineSweeperSolverPhaseSolved,
+    MineSweeperSolverPhaseStuck,
+} MineSweeperSolverPhase;
+
+/* Window of the frontier the solver's elimination stage works on at a time:
+ * open numbers (rows) and the hidden tiles around them (columns). */
+#define SOLVER_GAUSS_MAX_ROWS    (32u)
+#define SOLVER_GAUSS_MAX_COLUMNS (64u)
+
+/* Everything the solver needs between steps, so a verification can be spread
+ * over several ticks. What the solver has revealed and flagged lives here as
+ * one bit per tile (bit x of row y), never in the board's cells. A tile is in
+ * the flood ring at most once ever and in the edge worklist at most once at a
+ * time, so both rings are bounded by the tile count. */
+typedef struct {
+    uint32_t revealed[BOARD_MAX_HEIGHT];
+    uint32_t flagged[BOARD_MAX_HEIGHT];
+    uint32_t mines[BOARD_MAX_HEIGHT];
+    uint32_t numbers[4][BOARD_MAX_HEIGHT]; // bit k of every tile's number, one plane per k
+    uint16_t revealed_count;
+    uint32_t rows_dirty; // rows the row stage still has to look at
+    uint8_t rows_cursor;
+    uint16_t edges[BOARD_MAX_TILES];
+    uint16_t flood[BOARD_MAX_TILES];
+    uint8_t visited[BOARD_MINE_BITMAP_BYTES];
+    uint8_t queued[BOARD_MINE_BITMAP_BYTES]; // numbered tiles waiting in the edge worklist
+    uint16_t edges_head;
+    uint16_t edges_count;
+    uint16_t flood_head;
+    uint16_t flood_count;
+    uint16_t mines_left;
+    uint16_t pair_cursor; // next tile the pair pass looks at
+    uint16_t pair_scanned; // tiles it has looked at since the last progress
+    // Endgame count over the whole board against the mines left, see mine_sweeper_solver.c
+    uint8_t endgame_disjoint[BOARD_MINE_BITMAP_BYTES];
+    uint8_t endgame_cover[BOARD_MINE_BITMAP_BYTES];
+    uint16_t endgame_cursor;
+    uint16_t endgame_hidden;
+    uint16_t endgame_frontier;
+    uint16_t endgame_disjoint_tiles;
+    uint16_t endgame_lower;
+    uint16_t endgame_upper;
+    // Frontier equations being row-reduced, see mine_sweeper_solver.c
+    int8_t gauss_matrix[SOLVER_GAUSS_MAX_ROWS][SOLVER_GAUSS_MAX_COLUMNS];
+    int8_t gauss_mines[SOLVER_GAUSS_MAX_ROWS]; // right-hand side of each row
+    uint16_t gauss_tiles[SOLVER_GAUSS_MAX_COLUMNS]; // tile of each column
+    uint8_t gauss_row_count;
+    uint8_t gauss_column_count;
+    uint8_t gauss_rank;
+    uint8_t gauss_column; // next column to eliminate
+    uint8_t gauss_stage;
+    uint16_t gauss_start; // first tile of the current window
+    uint16_t gauss_next; // next tile to gather from
+    MineSweeperSolverPhase phase;
+} MineSweeperSolverState;
+
 typedef enum {
     MineSweeperGenerationStatusIdle = 0,
     MineSweeperGenerationStatusInProgress,
@@ -126,14 +238,31 @@ typedef enum {
     MineSweeperGenerationStatusFailed,
 } MineSweeperGenerationStatus;
 
+/* A job may be stepped on a worker thread while the GUI polls it: status,
+ * attempts_total, attempt_cost_us_q4, has_forced_board and whatever begin
+ * sets up are safe to read at any time, everything else belongs to whoever
+ * is currently stepping the job. */
 typedef struct {
     MineSweeperConfig config;
+    uint8_t strategy; // MineSweeperStrategy, picked at begin
+    float expected_attempts; // per playable board, from the atlas; 0 if unknown
     MineSweeperState latest_candidate;
-    uint32_t attempts_total;
+    atomic_uint_fast32_t attempts_total;
     uint32_t start_tick;
+    atomic_uint_fast32_t attempt_cost_us_q4; // EMA of one attempt's cost, microseconds << 4
     bool has_latest_candidate;
+    atomic_bool has_forced_board; // see minesweeper_engine_generation_has_forced_board
     bool latest_candidate_is_solved;
-    MineSweeperGenerationStatus status;
+    // Unsolved candidate the solver got furthest on, kept for forced starts
+    uint8_t best_candidate_mines[BOARD_MINE_BITMAP_BYTES];
+    uint16_t best_candidate_cleared;
+    bool has_best_candidate;
+    // Candidate verification in flight, resumed by the next step
+    MineSweeperSolverState solver;
+    bool verification_pending;
+    uint32_t attempt_cycles; // DWT cycles spent on the current attempt so far
+    atomic_bool cancel_requested;
+    _Atomic(MineSweeperGenerationStatus) status;
 } MineSweeperGenerationJob;
 
 typedef struct {
@@ -157,12 +286,50 @@ void board_init(MineSweeperBoard* board, uint8_t width, uint8_t height);
 
 void board_compute_neighbor_counts(MineSweeperBoard* board);
 
+/* 3BV (Bechtel's Board Benchmark Value): the least number of clicks that clears
+ * the board, i.e. openings plus numbers not bordering an opening. Needs the
+ * neighbor counts; scratch must hold BOARD_MAX_TILES entries. */
+uint16_t board_compute_3bv(const MineSweeperBoard* board, uint16_t* scratch);
+
 bool board_reveal_cell(MineSweeperBoard* board, uint8_t x, uint8_t y);
 
 uint16_t board_reveal_flood(MineSweeperBoard* board, uint8_t x, uint8_t y);
 
 void board_toggle_flag(MineSweeperBoard* board, uint8_t x, uint8_t y);
 
+void board_generate_candidate(MineSweeperBoard* board, uint16_t mine_count);
+
+void board_pack_mines(const MineSweeperBoard* board, uint8_t* bitmap);
+
+void board_unpack_mines(
+    MineSweeperBoard* board,
+    uint8_t width,
+    uint8_t height,
+    const uint8_t* bitmap);
+
+/* 8 transforms for square boards, 4 otherwise. */
+uint8_t board_transform_count(uint8_t width, uint8_t height);
+
+MineSweeperStartCorner board_transform_corner(MineSweeperTransform transform);
+
+/* Picks a random transform that starts at start_corner (any corner for Any) and
+ * is not set in used_mask. Returns MineSweeperTransformCount if none is left. */
+MineSweeperTransform board_pick_transform(
+    uint8_t width,
+    uint8_t height,
+    uint8_t start_corner,
+    uint8_t used_mask);
+
+/* Applies a transform to a packed mine bitmap. src and dst must not overlap. */
+void board_transform_mines(
+    const uint8_t* src,
+    uint8_t width,
+    uint8_t height,
+    MineSweeperTransform transform,
+    uint8_t* dst);
+
+uint16_t random_uniform_u16(uint16_t upper_exclusion);
+
 /* ---- ENGINE API ---- */
 
 MineSweeperResult minesweeper_engine_generation_begin(
@@ -172,18 +339,70 @@ MineSweeperResult minesweeper_engine_generation_begin(
 MineSweeperGenerationStatus
     minesweeper_engine_generation_step(MineSweeperGenerationJob* job, uint16_t attempt_budget);
 
+/* Runs as many attempts as are expected to fit in budget_us (at least one). */
+MineSweeperGenerationStatus
+    minesweeper_engine_generation_step_timed(MineSweeperGenerationJob* job, uint32_t budget_us);
+
 MineSweeperGenerationStatus
     minesweeper_engine_generation_status(const MineSweeperGenerationJob* job);
 
+/* Estimated milliseconds until the job has a board, from the atlas acceptance
+ * rate and the measured cost of an attempt. UINT32_MAX until an attempt has
+ * been timed or when the atlas has no estimate. Safe to call while another
+ * thread steps the job. */
+uint32_t minesweeper_engine_generation_eta_ms(const MineSweeperGenerationJob* job);
+
+/* True once finishing with allow_unsolved_fallback would get a board: a
+ * candidate has been concluded or is being verified. Safe to call while
+ * another thread steps the job. */
+bool minesweeper_engine_generation_has_forced_board(const MineSweeperGenerationJob* job);
+
 MineSweeperResult minesweeper_engine_generation_finish(
     MineSweeperGenerationJob* job,
     MineSweeperState* out_state,
     bool allow_unsolved_fallback);
 
+/* Advances a pending candidate verification by at most max_work_units. */
+MineSweeperSolverPhase
+    minesweeper_engine_solver_step(MineSweeperGenerationJob* job, uint32_t max_work_units);
+
+/* Like finish, but hands back the chosen board as a packed mine bitmap. */
+MineSweeperResult minesweeper_engine_generation_finish_mines(
+    MineSweeperGenerationJob* job,
+    uint8_t* mines_out,
+    bool allow_unsolved_fallback);
+
 void minesweeper_engine_generation_cancel(MineSweeperGenerationJob* job);
 
+/* Mines on a board of this config's size and difficulty. */
+uint16_t minesweeper_engine_mine_count(const MineSweeperConfig* config);
+
+/* Sets config's 3BV range to a MineSweeperClicksBand for its size and difficulty. */
+void minesweeper_engine_set_clicks_band(MineSweeperConfig* config, uint8_t band);
+
 void minesweeper_engine_new_game(MineSweeperState* game_state);
 
+/* Starts a game on a pregenerated board given as a packed mine bitmap in
+ * canonical orientation, turned by transform. */
+MineSweeperResult minesweeper_engine_load_board(
+    MineSweeperState* game_state,
+    const MineSweeperConfig* config,
+    const uint8_t* mine_bitmap,
+    MineSweeperTransform transform);
+
+/* Starts a game on an all-hidden board with no mines placed yet, so it can be
+ * shown while the real board is still being generated. The start corner is
+ * settled here, so the cursor can already sit on it. */
+MineSweeperResult minesweeper_engine_start_placeholder(
+    MineSweeperState* game_state,
+    const MineSweeperConfig* config);
+
+/* Puts the real mines (canonical orientation) under a placeholder game, turned
+ * to start from the placeholder's corner. Only valid before the first reveal;
+ * the cursor, clock and the player's flags are kept. */
+MineSweeperResult
+    minesweeper_engine_adopt_mines(MineSweeperState* game_state, const uint8_t* mine_bitmap);
+
 MineSweeperResult minesweeper_engine_reveal(MineSweeperState* game_state, uint16_t x, uint16_t y);
 
 MineSweeperResult minesweeper_engine_chord(MineSweeperState* game_state, uint16_t x, uint16_t y);
@@ -196,6 +415,10 @@ MineSweeperResult
 
 MineSweeperResult minesweeper_engine_move_to_closest_tile(MineSweeperState* game_state);
 
+/* Puts the cursor on (x, y), e.g. a tile a hint points at. */
+MineSweeperResult
+    minesweeper_engine_set_cursor(MineSweeperState* game_state, uint8_t x, uint8_t y);
+
 MineSweeperResult minesweeper_engine_reveal_all_mines(MineSweeperState* game_state);
 
 MineSweeperResult minesweeper_engine_check_win_conditions(MineSweeperState* game_state);
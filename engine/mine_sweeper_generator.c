@@ -0,0 +1,248 @@
+#include "mine_sweeper_generator.h"
+#include "mine_sweeper_solver.h"
+#include <furi.h>
+#include <stdlib.h>
+
+// Picks (uniformly) a revealed number that still borders undecided tiles.
+static bool board_pick_stuck_constraint(
+    const MineSweeperBoard* board,
+    const MineSweeperSolverState* solver,
+    uint8_t* out_x,
+    uint8_t* out_y) {
+    uint16_t seen = 0;
+
+    for (uint8_t y = 0; y < board->height; ++y) {
+        for (uint8_t x = 0; x < board->width; ++x) {
+            const MineSweeperCell cell = board->cells[board_index(board, x, y)];
+            if (!solver_tile_revealed(solver, x, y) || CELL_GET_NEIGHBORS(cell) == 0) continue;
+
+            bool has_undecided = false;
+            for (uint8_t n = 0; n < 8 && !has_undecided; ++n) {
+                const int16_t dx = (int16_t)x + neighbor_offsets[n][0];
+                const int16_t dy = (int16_t)y + neighbor_offsets[n][1];
+
+                if (!board_in_bounds(board, (int8_t)dx, (int8_t)dy)) continue;
+
+                has_undecided = solver_tile_undecided(solver, (uint8_t)dx, (uint8_t)dy);
+            }
+
+            if (!has_undecided) continue;
+
+            seen++;
+            if (random_uniform_u16(seen) == 0) {
+                *out_x = x;
+                *out_y = y;
+            }
+        }
+    }
+
+    return seen > 0;
+}
+
+// Spare tiles of row y for the constraint at (cx, cy) holding (or not holding) a
+// mine: undecided and outside its 3x3 scope. With interior_only they must also
+// be out of sight of every revealed number, so moving a mine there changes no
+// number the solver has read.
+static uint32_t board_spare_row(
+    const MineSweeperBoard* board,
+    const MineSweeperSolverState* solver,
+    uint8_t y,
+    uint8_t cx,
+    uint8_t cy,
+    bool is_mine,
+    bool interior_only) {
+    const uint32_t row_mask = board->width >= 32u ? UINT32_MAX : (1u << board->width) - 1u;
+    uint32_t spare = ~(solver->revealed[y] | solver->flagged[y]) & row_mask;
+
+    if (y + 1u >= cy && y <= cy + 1u) {
+        spare &= ~((1u << cx) | (1u << cx >> 1) | (1u << cx << 1));
+    }
+    if (interior_only) {
+        const uint32_t near = (y > 0 ? solver->revealed[y - 1u] : 0u) | solver->revealed[y] |
+                              (y + 1u < board->height ? solver->revealed[y + 1u] : 0u);
+        spare &= ~(near | (near << 1) | (near >> 1));
+    }
+    for (uint32_t rest = spare; rest; rest &= rest - 1u) {
+        const uint8_t x = (uint8_t)__builtin_ctz(rest);
+        if (CELL_IS_MINE(board->cells[board_index(board, x, y)]) != is_mine) {
+            spare &= ~(1u << x);
+        }
+    }
+
+    return spare;
+}
+
+static uint16_t board_count_spare(
+    const MineSweeperBoard* board,
+    const MineSweeperSolverState* solver,
+    uint8_t cx,
+    uint8_t cy,
+    bool is_mine,
+    bool interior_only) {
+    uint16_t count = 0;
+
+    for (uint8_t y = 0; y < board->height; ++y) {
+        count += (uint16_t)__builtin_popcount(
+            board_spare_row(board, solver, y, cx, cy, is_mine, interior_only));
+    }
+
+    return count;
+}
+
+// Picks a random spare tile, preferring ones no revealed number can see so the
+// solver has as few of the numbers it read change under it as possible.
+static uint16_t board_pick_spare(
+    const MineSweeperBoard* board,
+    const MineSweeperSolverState* solver,
+    uint8_t cx,
+    uint8_t cy,
+    bool is_mine) {
+    bool interior_only = true;
+    uint16_t count = board_count_spare(board, solver, cx, cy, is_mine, true);
+
+    if (count == 0) {
+        interior_only = false;
+        count = board_count_spare(board, solver, cx, cy, is_mine, false);
+    }
+
+    furi_assert(count > 0);
+    uint16_t target = random_uniform_u16(count);
+
+    for (uint8_t y = 0; y < board->height; ++y) {
+        uint32_t spare = board_spare_row(board, solver, y, cx, cy, is_mine, interior_only);
+        const uint16_t in_row = (uint16_t)__builtin_popcount(spare);
+
+        if (target >= in_row) {
+            target -= in_row;
+            continue;
+        }
+        while (target--) {
+            spare &= spare - 1u;
+        }
+        return board_index(board, (uint8_t)__builtin_ctz(spare), y);
+    }
+
+    furi_crash("spare tile vanished");
+}
+
+// Makes one stuck frontier number decidable by relocating mines between its
+// undecided neighbors and spare tiles elsewhere on the board. moved_rows gets
+// the rows whose mines changed.
+static bool board_perturb_stuck_constraint(
+    MineSweeperBoard* board,
+    const MineSweeperSolverState* solver,
+    uint32_t* moved_rows) {
+    uint8_t cx = 0;
+    uint8_t cy = 0;
+
+    if (!board_pick_stuck_constraint(board, solver, &cx, &cy)) {
+        return false;
+    }
+
+    uint8_t mines_in_scope = 0;
+    uint8_t safe_in_scope = 0;
+
+    for (uint8_t n = 0; n < 8; ++n) {
+        const int16_t dx = (int16_t)cx + neighbor_offsets[n][0];
+        const int16_t dy = (int16_t)cy + neighbor_offsets[n][1];
+
+        if (!board_in_bounds(board, (int8_t)dx, (int8_t)dy)) continue;
+
+        if (!solver_tile_undecided(solver, (uint8_t)dx, (uint8_t)dy)) continue;
+
+        const MineSweeperCell cell = board->cells[board_index(board, (uint8_t)dx, (uint8_t)dy)];
+        if (CELL_IS_MINE(cell)) {
+            mines_in_scope++;
+        } else {
+            safe_in_scope++;
+        }
+    }
+
+    const bool can_clear =
+        mines_in_scope <= board_count_spare(board, solver, cx, cy, false, false);
+    const bool can_fill = safe_in_scope <= board_count_spare(board, solver, cx, cy, true, false);
+
+    if (!can_clear && !can_fill) {
+        return false;
+    }
+
+    // Move as few mines as possible; clearing wins ties since it opens the board up.
+    const bool clear_scope = can_clear && (!can_fill || mines_in_scope <= safe_in_scope);
+    *moved_rows = 0;
+
+    for (uint8_t n = 0; n < 8; ++n) {
+        const int16_t dx = (int16_t)cx + neighbor_offsets[n][0];
+        const int16_t dy = (int16_t)cy + neighbor_offsets[n][1];
+
+        if (!board_in_bounds(board, (int8_t)dx, (int8_t)dy)) continue;
+
+        const uint16_t i = board_index(board, (uint8_t)dx, (uint8_t)dy);
+        const MineSweeperCell cell = board->cells[i];
+
+        if (!solver_tile_undecided(solver, (uint8_t)dx, (uint8_t)dy) ||
+            CELL_IS_MINE(cell) != clear_scope) {
+            continue;
+        }
+
+        // A mine leaving the scope needs a safe tile to swap with, and vice versa.
+        const uint16_t spare = board_pick_spare(board, solver, cx, cy, !clear_scope);
+
+        if (clear_scope) {
+            CELL_CLEAR_MINE(board->cells[i]);
+            CELL_SET_MINE(board->cells[spare]);
+        } else {
+            CELL_SET_MINE(board->cells[i]);
+            CELL_CLEAR_MINE(board->cells[spare]);
+        }
+        *moved_rows |= (1u << dy) | (1u << board_y(board, spare));
+    }
+
+    return true;
+}
+
+bool board_generate_constructive(
+    MineSweeperBoard* board,
+    uint16_t mine_count,
+    uint16_t* cleared_out) {
+    furi_assert(board);
+    furi_assert(cleared_out);
+
+    board_generate_candidate(board, mine_count);
+
+    // Where the solver got stuck is read from its state, so it outlives each pass.
+    MineSweeperSolverState* solver = malloc(sizeof(MineSweeperSolverState));
+    furi_check(solver);
+
+    const uint16_t total = (uint16_t)board->width * board->height;
+    bool solvable = false;
+    bool resumed = false;
+    solver_begin(solver, board);
+
+    for (uint16_t round = 0; round < total; ++round) {
+        if (solver_step(solver, board, UINT32_MAX) == MineSweeperSolverPhaseSolved) {
+            // Moved mines may have changed numbers earlier deductions used, so a
+            // board solved by resuming gets one fresh solve (and more repairs if needed).
+            if (!resumed) {
+                solvable = true;
+                break;
+            }
+            solver_begin(solver, board);
+            resumed = false;
+            continue;
+        }
+
+        uint32_t moved_rows = 0;
+        if (!board_perturb_stuck_constraint(board, solver, &moved_rows)) {
+            break;
+        }
+
+        board_compute_neighbor_counts(board);
+        solver_mines_moved(solver, board, moved_rows);
+        resumed = true;
+    }
+
+    *cleared_out = solver_revealed_count(solver, board);
+    free(solver);
+
+    return solvable;
+}
@@ -0,0 +1,40 @@
+#ifndef MINE_SWEEPER_GENERATOR_H
+#define MINE_SWEEPER_GENERATOR_H
+
+#include "mine_sweeper_engine.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+
+/** Constructive no-guess generation.
+  *
+  * Starts from a random candidate and runs the solver from 0,0. Whenever the
+  * solver gets stuck, the mines under one stuck frontier number are swapped
+  * with undecided tiles elsewhere so that the number becomes decidable (all of
+  * its undecided neighbors clear or all of them mines), and the solver resumes
+  * from where it stopped with only the rows around the swap to look at again.
+  * Spare tiles out of sight of revealed numbers are preferred, but the swap
+  * can still change numbers earlier deductions relied on, so a board solved
+  * by resuming is solved once more from scratch and repaired further if that
+  * gets stuck.
+  *
+  * A resumed pass decides at least the stuck number's tiles, but a fresh solve
+  * starts over, so there is no progress bound per round: the work is capped
+  * at one round per tile, each a resumed pass or a full solve. Returns false
+  * if the board could not be repaired in that; the caller should treat that
+  * as a failed attempt. cleared_out receives how many tiles the last solver
+  * pass revealed.
+  */
+bool board_generate_constructive(
+    MineSweeperBoard* board,
+    uint16_t mine_count,
+    uint16_t* cleared_out);
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+#endif // MINE_SWEEPER_GENERATOR_H
@@ -0,0 +1,957 @@
+#include "mine_sweeper_hint.h"
+#include "mine_sweeper_engine.h"
+#include "mine_sweeper_solver.h"
+#include <furi.h>
+#include <math.h>
+#include <string.h>
+
+#define HINT_NONE    (0xFFu)
+#define HINT_NO_TILE (0xFFFFu)
+
+typedef enum {
+    HintStageGather = 0,
+    HintStageGroup,
+    HintStageLookup, // the next group in the cache, or room for it
+    HintStageCount, // layouts of each group per number of mines
+    HintStageFold, // the other groups of one group, folded into others
+    HintStageWeigh, // that group's layouts again, each weighed by its mines
+    HintStageConclude,
+    HintStageDone,
+} HintStage;
+
+// What a var is set to while backtracking. Every var of a group starts at None
+// and is back at None once the group's layouts have all been tried.
+typedef enum {
+    HintChoiceNone = 0,
+    HintChoiceSafe,
+    HintChoiceMine,
+} HintChoice;
+
+typedef enum {
+    HintNodeMore = 0,
+    HintNodeLayout, // every var of the group is set and fits
+    HintNodeDone,
+} HintNode;
+
+static uint8_t hint_find(MineSweeperHintState* state, uint8_t var) {
+    while (state->var_group[var] != var) {
+        state->var_group[var] = state->var_group[state->var_group[var]];
+        var = state->var_group[var];
+    }
+    return var;
+}
+
+static void hint_union(MineSweeperHintState* state, uint8_t a, uint8_t b) {
+    a = hint_find(state, a);
+    b = hint_find(state, b);
+    if (a < b) {
+        state->var_group[b] = a;
+    } else if (b < a) {
+        state->var_group[a] = b;
+    }
+}
+
+static void hint_fail(MineSweeperHintState* state) {
+    state->phase = MineSweeperHintPhaseInconsistent;
+    state->stage = HintStageDone;
+}
+
+// One board row: counts hidden tiles and flags, and adds every open number
+// next to a hidden tile as a constraint on those tiles.
+static void hint_gather_row(MineSweeperHintState* state, const MineSweeperBoard* board) {
+    const uint8_t y = state->row;
+
+    for (uint8_t x = 0; x < board->width; ++x) {
+        const MineSweeperCell cell = board->cells[board_index(board, x, y)];
+
+        if (!CELL_IS_REVEALED(cell)) {
+            if (CELL_IS_FLAGGED(cell)) {
+                state->flags++;
+            } else {
+                state->hidden++;
+            }
+            continue;
+        }
+
+        uint16_t unknown[8];
+        uint8_t unknown_count = 0;
+        uint8_t new_vars = 0;
+        uint8_t flagged = 0;
+
+        for (uint8_t n = 0; n < 8; ++n) {
+            const int8_t nx = (int8_t)(x + neighbor_offsets[n][0]);
+            const int8_t ny = (int8_t)(y + neighbor_offsets[n][1]);
+            if (!board_in_bounds(board, nx, ny)) continue;
+
+            const uint16_t i = board_index(board, (uint8_t)nx, (uint8_t)ny);
+            const MineSweeperCell neighbor = board->cells[i];
+            if (CELL_IS_REVEALED(neighbor)) continue;
+
+            if (CELL_IS_FLAGGED(neighbor)) {
+                flagged++;
+            } else {
+                unknown[unknown_count++] = i;
+                new_vars += state->var_of[i] == HINT_NONE;
+            }
+        }
+
+        const uint8_t number = CELL_GET_NEIGHBORS(cell);
+        if (flagged > number || number - flagged > unknown_count) {
+            hint_fail(state);
+            return;
+        }
+
+        // Leaving a number out only allows more layouts, so what is certain
+        // without it is certain with it too.
+        if (unknown_count == 0 || state->constraint_count >= HINT_MAX_CONSTRAINTS ||
+            state->var_count + new_vars > HINT_MAX_VARS) {
+            continue;
+        }
+
+        const uint8_t c = (uint8_t)state->constraint_count++;
+        state->constraint_need[c] = number - flagged;
+        state->constraint_mines[c] = 0;
+        state->constraint_unknown[c] = unknown_count;
+        state->constraint_tile[c] = board_index(board, x, y);
+
+        for (uint8_t u = 0; u < unknown_count; ++u) {
+            uint8_t var = state->var_of[unknown[u]];
+            if (var == HINT_NONE) {
+                var = (uint8_t)state->var_count++;
+                state->var_of[unknown[u]] = var;
+                state->var_tile[var] = unknown[u];
+                state->var_constraint_count[var] = 0;
+                state->var_group[var] = var;
+                state->var_choice[var] = HintChoiceNone;
+            }
+            state->var_constraints[var][state->var_constraint_count[var]++] = c;
+            hint_union(state, var, state->var_of[unknown[0]]);
+        }
+    }
+}
+
+// Sorts the vars into groups, keeping each group in gathering order (row-major
+// from the numbers), which settles its numbers early while backtracking.
+static void hint_group(MineSweeperHintState* state) {
+    uint8_t group_of_root[HINT_MAX_VARS];
+    memset(group_of_root, HINT_NONE, sizeof(group_of_root));
+
+    // Every var points straight at its root, which is never a later var
+    for (uint16_t var = 0; var < state->var_count; ++var) {
+        state->var_group[var] = hint_find(state, (uint8_t)var);
+    }
+
+    state->group_count = 0;
+    for (uint16_t var = 0; var < state->var_count; ++var) {
+        const uint8_t root = state->var_group[var];
+        if (group_of_root[root] == HINT_NONE) {
+            const uint8_t g = (uint8_t)state->group_count++;
+            group_of_root[root] = g;
+            state->group_size[g] = 0;
+            state->group_dropped[g] = false;
+            state->group_entry[g] = HINT_NONE;
+        }
+        state->group_size[group_of_root[root]]++;
+    }
+
+    uint8_t fill[HINT_MAX_VARS];
+    uint16_t first = 0;
+    uint16_t counts = 0;
+    for (uint16_t g = 0; g < state->group_count; ++g) {
+        state->group_first[g] = (uint8_t)first;
+        state->group_counts[g] = counts;
+        fill[g] = (uint8_t)first;
+        first += state->group_size[g];
+        counts += state->group_size[g] + 1u;
+    }
+    memset(state->counts, 0, counts * sizeof(float));
+
+    for (uint16_t var = 0; var < state->var_count; ++var) {
+        const uint8_t g = group_of_root[state->var_group[var]];
+        state->order[fill[g]++] = (uint8_t)var;
+        state->var_group[var] = g;
+    }
+}
+
+// Places var, returning false if a number around it can no longer be met.
+static bool hint_assign(MineSweeperHintState* state, uint8_t var, bool mine) {
+    bool fits = true;
+
+    for (uint8_t k = 0; k < state->var_constraint_count[var]; ++k) {
+        const uint8_t c = state->var_constraints[var][k];
+        state->constraint_unknown[c]--;
+        state->constraint_mines[c] += mine;
+        fits = fits && state->constraint_mines[c] <= state->constraint_need[c] &&
+               state->constraint_mines[c] + state->constraint_unknown[c] >=
+                   state->constraint_need[c];
+    }
+    state->mines += mine;
+
+    return fits;
+}
+
+static void hint_unassign(MineSweeperHintState* state, uint8_t var, bool mine) {
+    for (uint8_t k = 0; k < state->var_constraint_count[var]; ++k) {
+        const uint8_t c = state->var_constraints[var][k];
+        state->constraint_unknown[c]++;
+        state->constraint_mines[c] -= mine;
+    }
+    state->mines -= mine;
+}
+
+static void hint_group_begin(MineSweeperHintState* state) {
+    state->depth = 0;
+    state->mines = 0;
+    state->nodes = 0;
+}
+
+// One step of the depth-first walk over the current group's layouts: safe is
+// tried before mine, and a var that breaks a number is not gone past.
+static HintNode hint_node(MineSweeperHintState* state) {
+    const uint8_t size = state->group_size[state->group];
+
+    if (state->depth == size) {
+        state->depth--;
+        return HintNodeLayout;
+    }
+
+    const uint8_t var = state->order[state->group_first[state->group] + state->depth];
+
+    switch (state->var_choice[var]) {
+    case HintChoiceNone:
+        state->var_choice[var] = HintChoiceSafe;
+        if (hint_assign(state, var, false)) state->depth++;
+        return HintNodeMore;
+    case HintChoiceSafe:
+        hint_unassign(state, var, false);
+        state->var_choice[var] = HintChoiceMine;
+        if (hint_assign(state, var, true)) state->depth++;
+        return HintNodeMore;
+    default:
+        hint_unassign(state, var, true);
+        state->var_choice[var] = HintChoiceNone;
+        if (state->depth == 0) return HintNodeDone;
+        state->depth--;
+        return HintNodeMore;
+    }
+}
+
+// Undoes a walk stopped half way.
+static void hint_group_abandon(MineSweeperHintState* state) {
+    const uint8_t first = state->group_first[state->group];
+
+    for (uint8_t k = 0; k < state->group_size[state->group]; ++k) {
+        const uint8_t var = state->order[first + k];
+        if (state->var_choice[var] != HintChoiceNone) {
+            hint_unassign(state, var, state->var_choice[var] == HintChoiceMine);
+            state->var_choice[var] = HintChoiceNone;
+        }
+    }
+}
+
+// Next group at or after state->group that was not dropped, for the weighing
+// stages, or Conclude once there is none.
+static void hint_next_weighed_group(MineSweeperHintState* state) {
+    while (state->group < state->group_count && state->group_dropped[state->group]) {
+        state->group++;
+    }
+
+    if (state->group == state->group_count) {
+        state->stage = HintStageConclude;
+        return;
+    }
+
+    state->others[0] = 1.0f;
+    state->others_len = 1;
+    state->other = 0;
+    state->stage = HintStageFold;
+}
+
+// Ways to fit the mines left outside the frontier for each number t of mines
+// on it, C(untouched tiles, mines left - t), scaled so the largest is 1.
+static void hint_binomials(MineSweeperHintState* state) {
+    const int32_t interior = (int32_t)state->hidden - state->frontier;
+    const int32_t mines = state->mines_left;
+    const int32_t lowest = mines > interior ? mines - interior : 0;
+    const int32_t highest = mines < state->frontier ? mines : state->frontier;
+
+    for (uint16_t t = 0; t <= state->frontier; ++t) {
+        state->binomial[t] = 0.0f;
+    }
+    if (lowest > highest) {
+        hint_fail(state);
+        return;
+    }
+
+    // C(n, m - 1) / C(n, m) = m / (n - m + 1), summed in logs from lowest up
+    float log_ways = 0.0f;
+    float log_most = 0.0f;
+    state->binomial[lowest] = 0.0f;
+    for (int32_t t = lowest; t < highest; ++t) {
+        log_ways += logf((float)(mines - t) / (float)(interior - mines + t + 1));
+        state->binomial[t + 1] = log_ways;
+        if (log_ways > log_most) log_most = log_ways;
+    }
+    for (int32_t t = lowest; t <= highest; ++t) {
+        state->binomial[t] = expf(state->binomial[t] - log_most);
+    }
+}
+
+static void hint_hash(uint32_t* key, uint16_t value) {
+    *key = (*key ^ (value & 0xFFu)) * 16777619u;
+    *key = (*key ^ (value >> 8)) * 16777619u;
+}
+
+// FNV-1a over the current group's tiles in order and the numbers around each,
+// everything its layouts depend on.
+static uint32_t hint_group_key(const MineSweeperHintState* state) {
+    const uint8_t first = state->group_first[state->group];
+    uint32_t key = 2166136261u;
+
+    for (uint8_t k = 0; k < state->group_size[state->group]; ++k) {
+        const uint8_t var = state->order[first + k];
+        hint_hash(&key, state->var_tile[var]);
+        for (uint8_t n = 0; n < state->var_constraint_count[var]; ++n) {
+            const uint8_t c = state->var_constraints[var][n];
+            hint_hash(&key, state->constraint_tile[c]);
+            hint_hash(&key, state->constraint_need[c]);
+        }
+    }
+
+    return key;
+}
+
+static uint16_t hint_cache_length(const MineSweeperHintCacheEntry* entry) {
+    return entry->tiles ? entry->span * (entry->size + 1u) : entry->span;
+}
+
+static void hint_cache_evict(MineSweeperHintState* state, uint8_t e) {
+    MineSweeperHintCacheEntry* entry = &state->cache[e];
+    const uint16_t length = hint_cache_length(entry);
+    const uint16_t end = entry->offset + length;
+
+    memmove(
+        &state->cache_pool[entry->offset],
+        &state->cache_pool[end],
+        (state->cache_pool_used - end) * sizeof(float));
+    for (uint8_t k = 0; k < HINT_CACHE_ENTRIES; ++k) {
+        if (state->cache[k].used != 0 && state->cache[k].offset > entry->offset) {
+            state->cache[k].offset -= length;
+        }
+    }
+
+    state->cache_pool_used -= length;
+    entry->used = 0;
+}
+
+// An entry for the current group with length floats at the end of the pool,
+// making room by dropping the least recently used groups not in this hint.
+static uint8_t hint_cache_alloc(MineSweeperHintState* state, uint16_t length) {
+    if (length > HINT_CACHE_FLOATS) return HINT_NONE;
+
+    for (;;) {
+        uint8_t free = HINT_NONE;
+        uint8_t oldest = HINT_NONE;
+        for (uint8_t k = 0; k < HINT_CACHE_ENTRIES; ++k) {
+            const uint32_t used = state->cache[k].used;
+            if (used == 0) {
+                free = k;
+            } else if (
+                used != state->cache_clock &&
+                (oldest == HINT_NONE || used < state->cache[oldest].used)) {
+                oldest = k;
+            }
+        }
+
+        if (free != HINT_NONE && state->cache_pool_used + length <= HINT_CACHE_FLOATS) {
+            MineSweeperHintCacheEntry* entry = &state->cache[free];
+            entry->key = state->group_key;
+            entry->used = state->cache_clock;
+            entry->offset = state->cache_pool_used;
+            entry->first_tile = state->var_tile[state->order[state->group_first[state->group]]];
+            entry->size = state->group_size[state->group];
+            entry->lowest = 0;
+            entry->span = 0;
+            entry->tiles = false;
+            memset(&state->cache_pool[entry->offset], 0, length * sizeof(float));
+            state->cache_pool_used += length;
+            return free;
+        }
+
+        if (oldest == HINT_NONE) return HINT_NONE;
+        hint_cache_evict(state, oldest);
+    }
+}
+
+// Keeps the current group's counts, narrowed to the numbers of mines its
+// layouts actually have. A group counted into an entry with its tiles (the
+// last in the pool) is narrowed in place; a bigger one keeps its counts only.
+static void hint_cache_store(MineSweeperHintState* state) {
+    const float* counts = &state->counts[state->group_counts[state->group]];
+    const uint8_t size = state->group_size[state->group];
+
+    uint8_t lowest = 0;
+    while (counts[lowest] <= 0.0f) {
+        lowest++;
+    }
+    uint8_t highest = size;
+    while (counts[highest] <= 0.0f) {
+        highest--;
+    }
+    const uint8_t span = highest - lowest + 1u;
+
+    uint8_t e = state->group_entry[state->group];
+    if (e == HINT_NONE) {
+        e = hint_cache_alloc(state, span);
+        if (e == HINT_NONE) return;
+    }
+
+    MineSweeperHintCacheEntry* entry = &state->cache[e];
+    float* pool = &state->cache_pool[entry->offset];
+    const uint8_t full = size + 1u;
+
+    for (uint8_t m = 0; m < span; ++m) {
+        pool[m] = counts[lowest + m];
+    }
+    // Tile rows only move down, so going forwards never overwrites a later one
+    for (uint8_t k = 0; entry->tiles && k < size; ++k) {
+        for (uint8_t m = 0; m < span; ++m) {
+            pool[span + k * span + m] = pool[full + k * full + lowest + m];
+        }
+    }
+
+    entry->lowest = lowest;
+    entry->span = span;
+    state->cache_pool_used = entry->offset + hint_cache_length(entry);
+    state->group_entry[state->group] = e;
+}
+
+static void hint_next_counted_group(MineSweeperHintState* state) {
+    state->group++;
+    if (state->group < state->group_count) {
+        state->stage = HintStageLookup;
+        return;
+    }
+
+    hint_binomials(state);
+    if (state->phase != MineSweeperHintPhaseRunning) return;
+
+    state->group = 0;
+    hint_next_weighed_group(state);
+}
+
+static void hint_lookup_step(MineSweeperHintState* state) {
+    const uint8_t g = state->group;
+    const uint8_t size = state->group_size[g];
+    const uint16_t first_tile = state->var_tile[state->order[state->group_first[g]]];
+    state->group_key = hint_group_key(state);
+
+    for (uint8_t e = 0; e < HINT_CACHE_ENTRIES; ++e) {
+        MineSweeperHintCacheEntry* entry = &state->cache[e];
+        if (entry->used == 0 || entry->key != state->group_key || entry->size != size ||
+            entry->first_tile != first_tile) {
+            continue;
+        }
+
+        entry->used = state->cache_clock;
+        if (entry->span == 0) {
+            state->group_dropped[g] = true;
+        } else {
+            state->group_entry[g] = e;
+            for (uint8_t m = 0; m < entry->span; ++m) {
+                state->counts[state->group_counts[g] + entry->lowest + m] =
+                    state->cache_pool[entry->offset + m];
+            }
+            state->frontier += size;
+        }
+        hint_next_counted_group(state);
+        return;
+    }
+
+    // Room for every number of mines up front, narrowed once counted
+    if ((size + 1u) * (size + 1u) <= HINT_CACHE_FLOATS / 2u) {
+        state->group_entry[g] = hint_cache_alloc(state, (size + 1u) * (size + 1u));
+        if (state->group_entry[g] != HINT_NONE) {
+            state->cache[state->group_entry[g]].tiles = true;
+            state->cache[state->group_entry[g]].span = size + 1u;
+        }
+    }
+    hint_group_begin(state);
+    state->stage = HintStageCount;
+}
+
+static void hint_count_step(MineSweeperHintState* state) {
+    const HintNode node = hint_node(state);
+    const uint8_t e = state->group_entry[state->group];
+    const uint8_t size = state->group_size[state->group];
+    state->nodes++;
+
+    if (node == HintNodeLayout) {
+        state->counts[state->group_counts[state->group] + state->mines] += 1.0f;
+        if (e == HINT_NONE) return;
+
+        float* hits = &state->cache_pool[state->cache[e].offset + size + 1u];
+        const uint8_t first = state->group_first[state->group];
+        for (uint8_t k = 0; k < size; ++k) {
+            if (state->var_choice[state->order[first + k]] == HintChoiceMine) {
+                hits[k * (size + 1u) + state->mines] += 1.0f;
+            }
+        }
+        return;
+    }
+
+    if (node == HintNodeMore && state->nodes <= HINT_MAX_NODES) return;
+
+    if (node == HintNodeMore) {
+        // Remembered with no counts, so the next hint doesn't try it again
+        hint_group_abandon(state);
+        state->group_dropped[state->group] = true;
+        if (e != HINT_NONE) hint_cache_evict(state, e);
+        state->group_entry[state->group] = HINT_NONE;
+        hint_cache_alloc(state, 0);
+    } else {
+        bool any = false;
+        for (uint8_t m = 0; m <= size; ++m) {
+            any = any || state->counts[state->group_counts[state->group] + m] > 0.0f;
+        }
+        if (!any) {
+            if (e != HINT_NONE) hint_cache_evict(state, e);
+            hint_fail(state);
+            return;
+        }
+        hint_cache_store(state);
+        state->frontier += size;
+    }
+
+    hint_next_counted_group(state);
+}
+
+static uint8_t hint_percent(float weight, float total) {
+    if (weight <= 0.0f) return 0;
+    if (weight >= total) return 100;
+
+    const uint8_t percent = (uint8_t)(weight * 100.0f / total + 0.5f);
+    return percent < 1u ? 1u : (percent > 99u ? 99u : percent);
+}
+
+// Turns the current group's weights into probabilities and moves on.
+static void hint_settle_group(MineSweeperHintState* state) {
+    if (state->group_total <= 0.0f) {
+        hint_fail(state);
+        return;
+    }
+
+    const uint8_t first = state->group_first[state->group];
+    for (uint8_t k = 0; k < state->group_size[state->group]; ++k) {
+        const uint8_t var = state->order[first + k];
+        state->var_percent[var] = hint_percent(state->var_weight[var], state->group_total);
+        state->var_weight[var] /= state->group_total;
+    }
+
+    state->group++;
+    hint_next_weighed_group(state);
+}
+
+// Weighs a cached group from its counts, without walking its layouts again.
+// A tile that is a mine in every layout has the same counts as the group, so
+// the two sums come out equal and it still reads as certain.
+static void hint_weigh_cached(MineSweeperHintState* state) {
+    const MineSweeperHintCacheEntry* entry = &state->cache[state->group_entry[state->group]];
+    const float* counts = &state->cache_pool[entry->offset];
+    const float* weights = &state->scratch[entry->lowest];
+    const uint8_t first = state->group_first[state->group];
+
+    state->group_total = 0.0f;
+    for (uint8_t m = 0; m < entry->span; ++m) {
+        state->group_total += counts[m] * weights[m];
+    }
+
+    for (uint8_t k = 0; k < entry->size; ++k) {
+        const float* hits = &counts[entry->span + k * entry->span];
+        float weight = 0.0f;
+        for (uint8_t m = 0; m < entry->span; ++m) {
+            weight += hits[m] * weights[m];
+        }
+        state->var_weight[state->order[first + k]] = weight;
+    }
+
+    hint_settle_group(state);
+}
+
+// Folds one other group's counts into others, or once all are in, turns them
+// into the weight of each mine count of the current group (into scratch).
+static void hint_fold_step(MineSweeperHintState* state) {
+    if (state->other < state->group_count) {
+        const uint8_t d = state->other++;
+        if (d == state->group || state->group_dropped[d]) return;
+
+        const float* counts = &state->counts[state->group_counts[d]];
+        const uint16_t size = state->group_size[d];
+        float most = 0.0f;
+
+        for (uint16_t t = 0; t < state->others_len + size; ++t) {
+            float sum = 0.0f;
+            for (uint16_t m = 0; m <= size && m <= t; ++m) {
+                if (t - m < state->others_len) sum += state->others[t - m] * counts[m];
+            }
+            state->scratch[t] = sum;
+            if (sum > most) most = sum;
+        }
+
+        state->others_len += size;
+        for (uint16_t t = 0; t < state->others_len; ++t) {
+            state->others[t] = most > 0.0f ? state->scratch[t] / most : 0.0f;
+        }
+        return;
+    }
+
+    const float* counts = &state->counts[state->group_counts[state->group]];
+    const uint8_t size = state->group_size[state->group];
+    float most = 0.0f;
+    float all = 0.0f;
+    float interior_mines = 0.0f;
+
+    for (uint8_t m = 0; m <= size; ++m) {
+        float weight = 0.0f;
+        for (uint16_t t = 0; t < state->others_len; ++t) {
+            const float ways = state->others[t] * state->binomial[m + t];
+            weight += ways;
+            interior_mines += counts[m] * ways * (float)((int32_t)state->mines_left - m - t);
+        }
+        state->scratch[m] = weight;
+        all += counts[m] * weight;
+        if (weight > most) most = weight;
+    }
+
+    if (most <= 0.0f) {
+        hint_fail(state);
+        return;
+    }
+
+    for (uint8_t m = 0; m <= size; ++m) {
+        state->scratch[m] /= most;
+    }
+
+    const uint16_t interior = state->hidden - state->frontier;
+    if (!state->interior_known && interior > 0) {
+        state->interior_probability = interior_mines / all / (float)interior;
+        state->interior_known = true;
+    }
+
+    const uint8_t e = state->group_entry[state->group];
+    if (e != HINT_NONE && state->cache[e].tiles) {
+        hint_weigh_cached(state);
+        return;
+    }
+
+    const uint8_t first = state->group_first[state->group];
+    for (uint8_t k = 0; k < size; ++k) {
+        state->var_weight[state->order[first + k]] = 0.0f;
+    }
+    state->group_total = 0.0f;
+    hint_group_begin(state);
+    state->stage = HintStageWeigh;
+}
+
+static void hint_weigh_step(MineSweeperHintState* state) {
+    const HintNode node = hint_node(state);
+    const uint8_t first = state->group_first[state->group];
+    const uint8_t size = state->group_size[state->group];
+
+    if (node == HintNodeLayout) {
+        const float weight = state->scratch[state->mines];
+        state->group_total += weight;
+        for (uint8_t k = 0; k < size; ++k) {
+            const uint8_t var = state->order[first + k];
+            if (state->var_choice[var] == HintChoiceMine) state->var_weight[var] += weight;
+        }
+        return;
+    }
+
+    if (node == HintNodeMore) return;
+
+    hint_settle_group(state);
+}
+
+static bool hint_var_weighed(const MineSweeperHintState* state, uint8_t var) {
+    return var != HINT_NONE && !state->group_dropped[state->var_group[var]];
+}
+
+// Picks the safest tile: the frontier's lowest, or an untouched tile if those
+// are strictly safer, the one with the fewest neighbors (a corner opens most).
+static void hint_conclude(MineSweeperHintState* state, const MineSweeperBoard* board) {
+    const uint16_t interior = state->hidden - state->frontier;
+    if (!state->interior_known && interior > 0) {
+        state->interior_probability = (float)state->mines_left / (float)interior;
+    }
+    state->interior_percent = hint_percent(state->interior_probability, 1.0f);
+
+    float best = 2.0f;
+    for (uint16_t var = 0; var < state->var_count; ++var) {
+        if (hint_var_weighed(state, (uint8_t)var) && state->var_weight[var] < best) {
+            best = state->var_weight[var];
+            state->best_tile = state->var_tile[var];
+            state->best_percent = state->var_percent[var];
+        }
+    }
+
+    if (interior > 0 && state->interior_probability < best) {
+        uint8_t fewest = 9;
+        const uint16_t tiles = (uint16_t)board->width * board->height;
+        for (uint16_t i = 0; i < tiles; ++i) {
+            const MineSweeperCell cell = board->cells[i];
+            if (CELL_IS_REVEALED(cell) || CELL_IS_FLAGGED(cell) ||
+                hint_var_weighed(state, state->var_of[i])) {
+                continue;
+            }
+
+            const uint8_t x = board_x(board, i);
+            const uint8_t y = board_y(board, i);
+            const uint8_t columns = 1u + (x > 0) + (x + 1u < board->width);
+            const uint8_t rows = 1u + (y > 0) + (y + 1u < board->height);
+            const uint8_t neighbors = columns * rows - 1u;
+            if (neighbors < fewest) {
+                fewest = neighbors;
+                state->best_tile = i;
+                state->best_percent = state->interior_percent;
+            }
+        }
+    }
+
+    state->phase = MineSweeperHintPhaseReady;
+    state->stage = HintStageDone;
+}
+
+// A group dropped while being counted leaves its entry half filled; it must
+// not be found by the next hint.
+static void hint_cache_drop_counting(MineSweeperHintState* state) {
+    if (state->stage != HintStageCount) return;
+
+    const uint8_t e = state->group_entry[state->group];
+    if (e != HINT_NONE) hint_cache_evict(state, e);
+    state->group_entry[state->group] = HINT_NONE;
+}
+
+void hint_reset(MineSweeperHintState* state) {
+    furi_assert(state);
+
+    hint_cache_drop_counting(state);
+    state->phase = MineSweeperHintPhaseIdle;
+    state->stage = HintStageDone;
+    state->sure_shown = false;
+}
+
+void hint_begin(MineSweeperHintState* state, const MineSweeperBoard* board) {
+    furi_assert(state);
+    furi_assert(board);
+
+    hint_cache_drop_counting(state);
+    memset(state->var_of, HINT_NONE, sizeof(state->var_of));
+    state->var_count = 0;
+    state->constraint_count = 0;
+    state->group_count = 0;
+    state->group = 0;
+    state->frontier = 0;
+    state->hidden = 0;
+    state->flags = 0;
+    state->row = 0;
+    state->interior_known = false;
+    state->interior_probability = 0.0f;
+    state->stage = HintStageGather;
+    state->phase = MineSweeperHintPhaseRunning;
+
+    // Entries this hint uses are stamped with it and kept until it is done
+    state->cache_clock++;
+    if (state->cache_clock == 0) {
+        memset(state->cache, 0, sizeof(state->cache));
+        state->cache_pool_used = 0;
+        state->cache_clock = 1;
+    }
+}
+
+MineSweeperHintPhase hint_step(
+    MineSweeperHintState* state,
+    const MineSweeperBoard* board,
+    uint32_t max_work_units) {
+    furi_assert(state);
+    furi_assert(board);
+
+    for (uint32_t unit = 0; unit < max_work_units && state->phase == MineSweeperHintPhaseRunning;
+         ++unit) {
+        switch (state->stage) {
+        case HintStageGather:
+            hint_gather_row(state, board);
+            if (++state->row == board->height && state->phase == MineSweeperHintPhaseRunning) {
+                state->stage = HintStageGroup;
+            }
+            break;
+        case HintStageGroup:
+            if (state->flags > board->mine_count) {
+                hint_fail(state);
+                break;
+            }
+            state->mines_left = board->mine_count - state->flags;
+            hint_group(state);
+            hint_group_begin(state);
+            state->stage = state->group_count > 0 ? HintStageLookup : HintStageConclude;
+            if (state->group_count == 0) hint_binomials(state);
+            break;
+        case HintStageLookup:
+            hint_lookup_step(state);
+            break;
+        case HintStageCount:
+            hint_count_step(state);
+            break;
+        case HintStageFold:
+            hint_fold_step(state);
+            break;
+        case HintStageWeigh:
+            hint_weigh_step(state);
+            break;
+        case HintStageConclude:
+            hint_conclude(state, board);
+            break;
+        default:
+            break;
+        }
+    }
+
+    return state->phase;
+}
+
+bool hint_best_tile(const MineSweeperHintState* state, uint16_t* tile, uint8_t* percent) {
+    furi_assert(state);
+
+    if (state->phase != MineSweeperHintPhaseReady) return false;
+
+    if (tile) *tile = state->best_tile;
+    if (percent) *percent = state->best_percent;
+    return true;
+}
+
+int8_t hint_tile_percent(
+    const MineSweeperHintState* state,
+    const MineSweeperBoard* board,
+    uint8_t x,
+    uint8_t y) {
+    furi_assert(state);
+    furi_assert(board);
+
+    const uint16_t i = board_index(board, x, y);
+    const MineSweeperCell cell = board->cells[i];
+    if (CELL_IS_REVEALED(cell) || CELL_IS_FLAGGED(cell)) return -1;
+
+    if (state->sure_shown && i == state->sure_tile) return state->sure_mine ? 100 : 0;
+    if (state->phase != MineSweeperHintPhaseReady) return -1;
+
+    const uint8_t var = state->var_of[i];
+    return (int8_t)(hint_var_weighed(state, var) ? state->var_percent[var] :
+                                                   state->interior_percent);
+}
+
+void hint_new_board(MineSweeperHintState* state) {
+    furi_assert(state);
+
+    state->solver.phase = MineSweeperSolverPhaseIdle;
+    state->sure_shown = false;
+}
+
+void hint_follow(MineSweeperHintState* state, const MineSweeperBoard* board) {
+    furi_assert(state);
+    furi_assert(board);
+
+    if (state->solver.phase == MineSweeperSolverPhaseIdle) {
+        solver_begin_unopened(&state->solver, board);
+        memset(state->seen, 0, sizeof(state->seen));
+        state->seen_count = 0;
+    }
+
+    for (uint8_t y = 0; y < board->height; ++y) {
+        const MineSweeperCell* cells = &board->cells[y * board->width];
+        uint32_t revealed = 0;
+        for (uint8_t x = 0; x < board->width; ++x) {
+            if (CELL_IS_REVEALED(cells[x])) revealed |= 1u << x;
+        }
+
+        uint32_t opened = revealed & ~state->seen[y];
+        state->seen[y] |= opened;
+        state->seen_count += (uint16_t)__builtin_popcount(opened);
+        while (opened) {
+            const uint16_t i = (uint16_t)(y * board->width + __builtin_ctz(opened));
+            opened &= opened - 1u;
+            solver_reveal(&state->solver, board, i);
+        }
+    }
+}
+
+MineSweeperSolverPhase hint_deduce_step(
+    MineSweeperHintState* state,
+    const MineSweeperBoard* board,
+    uint32_t max_work_units) {
+    furi_assert(state);
+    furi_assert(board);
+
+    for (uint32_t unit = 0; unit < max_work_units; ++unit) {
+        // The solver has opened a tile the player hasn't; going on would use its number.
+        if (state->solver.revealed_count > state->seen_count) break;
+        if (solver_step(&state->solver, board, 1) != MineSweeperSolverPhaseRunning) break;
+    }
+
+    return state->solver.phase;
+}
+
+bool hint_sure_tile(
+    MineSweeperHintState* state,
+    const MineSweeperBoard* board,
+    uint8_t x,
+    uint8_t y,
+    uint16_t* tile,
+    bool* mine) {
+    furi_assert(state);
+    furi_assert(board);
+
+    const MineSweeperSolverState* solver = &state->solver;
+    if (solver->phase == MineSweeperSolverPhaseIdle) return false;
+
+    const uint32_t row_mask = board->width >= 32u ? UINT32_MAX : (1u << board->width) - 1u;
+    uint16_t best = HINT_NO_TILE;
+    uint8_t best_distance = UINT8_MAX;
+    bool best_mine = true;
+
+    for (uint8_t row = 0; row < board->height; ++row) {
+        // Once every mine is flagged, whatever is left is safe
+        const uint32_t safe = solver->phase == MineSweeperSolverPhaseSolved ?
+                                  ~(solver->flagged[row] | state->seen[row]) & row_mask :
+                                  solver->revealed[row] & ~state->seen[row];
+        uint32_t sure = safe | solver->flagged[row];
+
+        while (sure) {
+            const uint8_t col = (uint8_t)__builtin_ctz(sure);
+            sure &= sure - 1u;
+
+            const uint16_t i = (uint16_t)(row * board->width + col);
+            if (CELL_IS_FLAGGED(board->cells[i])) continue;
+
+            const bool is_mine = ((safe >> col) & 1u) == 0u;
+            const uint8_t dx = col > x ? col - x : x - col;
+            const uint8_t dy = row > y ? row - y : y - row;
+            const uint8_t distance = dx > dy ? dx : dy;
+
+            // Safe tiles first, then the nearest
+            if (is_mine != best_mine ? !is_mine : distance < best_distance) {
+                best = i;
+                best_distance = distance;
+                best_mine = is_mine;
+            }
+        }
+    }
+
+    if (best == HINT_NO_TILE) return false;
+
+    state->sure_tile = best;
+    state->sure_mine = best_mine;
+    state->sure_shown = true;
+    if (tile) *tile = best;
+    if (mine) *mine = best_mine;
+    return true;
+}
@@ -0,0 +1,182 @@
+#ifndef MINE_SWEEPER_HINT_H
+#define MINE_SWEEPER_HINT_H
+
+#include "mine_sweeper_engine.h"
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+
+/** Mine probabilities for the player.
+  *
+  * Works only from what the player sees in the board's cells: open numbers,
+  * flags (taken to be mines) and the mines left after them, never the mine
+  * bits. The hidden tiles next to numbers (the frontier) split into groups no
+  * number links. Each group's mine layouts are enumerated by backtracking and
+  * counted per number of mines, and the groups are then weighed against each
+  * other and the hidden tiles no number touches by how many ways the mines
+  * left fit there (binomial coefficients).
+  *
+  * Work is done in small units, so a hint can be spread over GUI ticks.
+  *
+  * A group's layouts depend only on its own tiles and numbers, and a move
+  * leaves most groups as they were. So each group's counts, and for each of
+  * its tiles the layouts with a mine there, are kept in a small LRU cache
+  * keyed by a hash of the group. A later hint only enumerates the groups the
+  * board's changes touched, and a group cached with its tiles is weighed
+  * without being enumerated again.
+  *
+  * Tiles the player can already be sure of need none of this. A solver
+  * (mine_sweeper_solver.h) follows the game, taking in every tile the player
+  * opens but none of their flags, and is stepped in the background. It only
+  * ever reads numbers the player has seen: once it opens a safe tile the
+  * player hasn't, it waits for them, and that tile is the next sure hint.
+  */
+
+#define HINT_MAX_VARS        (255u) // frontier tiles; numbers needing more are left out
+#define HINT_MAX_CONSTRAINTS (255u) // open numbers next to the frontier
+#define HINT_MAX_NODES       (1u << 18) // per group; a bigger one counts as untouched tiles
+#define HINT_CACHE_ENTRIES   (16u) // groups kept between hints
+#define HINT_CACHE_FLOATS    (1024u) // layout counts of all of them together
+
+typedef enum {
+    MineSweeperHintPhaseIdle = 0,
+    MineSweeperHintPhaseRunning,
+    MineSweeperHintPhaseReady,
+    // No layout fits the numbers and flags, so some flag is wrong
+    MineSweeperHintPhaseInconsistent,
+} MineSweeperHintPhase;
+
+/* A cached group: layouts per number of mines from lowest on (span of them),
+ * then if tiles is set, for each of its tiles in group order the layouts with
+ * a mine there. Groups too big for that keep their counts only, and ones that
+ * hit HINT_MAX_NODES are kept with a span of 0. */
+typedef struct {
+    uint32_t key; // hash of the group's tiles and the numbers around them
+    uint32_t used; // hint that last used it, 0 if the entry is free
+    uint16_t offset; // into cache_pool
+    uint16_t first_tile; // checked along with size against hash collisions
+    uint8_t size;
+    uint8_t lowest;
+    uint8_t span;
+    bool tiles;
+} MineSweeperHintCacheEntry;
+
+/* Everything a hint needs between steps. Frontier tiles ("vars") and the
+ * numbers around them ("constraints") are indexed by uint8_t, 0xFF for none. */
+typedef struct {
+    uint8_t var_of[BOARD_MAX_TILES];
+    uint16_t var_tile[HINT_MAX_VARS];
+    uint8_t var_constraints[HINT_MAX_VARS][8];
+    uint8_t var_constraint_count[HINT_MAX_VARS];
+    uint8_t var_group[HINT_MAX_VARS]; // union-find parent while gathering, then group
+    uint8_t var_choice[HINT_MAX_VARS]; // backtracking state, see mine_sweeper_hint.c
+    uint8_t var_percent[HINT_MAX_VARS];
+    float var_weight[HINT_MAX_VARS]; // weighted layouts with a mine here, then probability
+    uint8_t constraint_need[HINT_MAX_CONSTRAINTS]; // number minus the flags around it
+    uint8_t constraint_mines[HINT_MAX_CONSTRAINTS]; // mines placed so far
+    uint8_t constraint_unknown[HINT_MAX_CONSTRAINTS]; // tiles not placed yet
+    uint16_t constraint_tile[HINT_MAX_CONSTRAINTS];
+    uint8_t order[HINT_MAX_VARS]; // vars sorted by group
+    uint8_t group_first[HINT_MAX_VARS]; // into order
+    uint8_t group_size[HINT_MAX_VARS];
+    uint16_t group_counts[HINT_MAX_VARS]; // into counts
+    bool group_dropped[HINT_MAX_VARS]; // hit HINT_MAX_NODES
+    uint8_t group_entry[HINT_MAX_VARS]; // cache entry holding the group, 0xFF if none
+    float counts[HINT_MAX_VARS * 2u]; // layouts of each group per number of mines
+    float binomial[HINT_MAX_VARS + 1u]; // ways to fit the rest, per frontier mines
+    float others[HINT_MAX_VARS + 1u]; // layouts of the other groups per mines
+    float scratch[HINT_MAX_VARS + 1u];
+    float group_total;
+    float interior_probability;
+    uint32_t nodes;
+    uint16_t var_count;
+    uint16_t constraint_count;
+    uint16_t group_count;
+    uint16_t others_len;
+    uint16_t frontier; // vars in groups that were not dropped
+    uint16_t hidden; // hidden tiles without a flag
+    uint16_t flags;
+    uint16_t mines_left; // mine count minus flags
+    uint16_t best_tile;
+    uint8_t best_percent;
+    uint8_t interior_percent;
+    uint8_t row; // next row to gather
+    uint8_t group; // group being worked on
+    uint8_t other; // next group to fold into others
+    uint8_t depth;
+    uint8_t mines; // mines in the layout being built
+    uint8_t stage;
+    bool interior_known;
+    MineSweeperHintPhase phase;
+    // Kept across hints; zeroed memory is an empty cache
+    MineSweeperHintCacheEntry cache[HINT_CACHE_ENTRIES];
+    float cache_pool[HINT_CACHE_FLOATS];
+    uint16_t cache_pool_used;
+    uint32_t cache_clock; // hints begun so far
+    uint32_t group_key; // of the group being looked up or counted
+    // Following the game, kept until the board is replaced
+    MineSweeperSolverState solver;
+    uint32_t seen[BOARD_MAX_HEIGHT]; // tiles the player had revealed when last followed
+    uint16_t seen_count;
+    uint16_t sure_tile; // the last sure hint's tile
+    bool sure_mine;
+    bool sure_shown; // until the board changes
+} MineSweeperHintState;
+
+/* Drops any hint, e.g. once the board changes. */
+void hint_reset(MineSweeperHintState* state);
+
+/* Starts a hint on the board as the player sees it. The cache is kept. */
+void hint_begin(MineSweeperHintState* state, const MineSweeperBoard* board);
+
+/* Runs at most max_work_units units (a board row gathered, a layout tried, a
+ * group folded in) and returns the phase reached. */
+MineSweeperHintPhase hint_step(
+    MineSweeperHintState* state,
+    const MineSweeperBoard* board,
+    uint32_t max_work_units);
+
+/* Once Ready: the hidden tile least likely to be a mine, preferring ones next
+ * to a number on ties, and that chance in percent. */
+bool hint_best_tile(const MineSweeperHintState* state, uint16_t* tile, uint8_t* percent);
+
+/* Once Ready: a hidden, unflagged tile's chance of being a mine in percent,
+ * 0 and 100 only when certain. The last sure hint's tile is 0 or 100 even
+ * before. -1 for other tiles or before Ready. */
+int8_t hint_tile_percent(
+    const MineSweeperHintState* state,
+    const MineSweeperBoard* board,
+    uint8_t x,
+    uint8_t y);
+
+/* Stops following the game, once the board or its mines are replaced. */
+void hint_new_board(MineSweeperHintState* state);
+
+/* Takes in the tiles the player has opened since the last call, starting to
+ * follow the game on the first one. */
+void hint_follow(MineSweeperHintState* state, const MineSweeperBoard* board);
+
+/* Runs at most max_work_units solver units towards the next sure tile, none
+ * while one is waiting for the player, and returns the solver's phase. */
+MineSweeperSolverPhase hint_deduce_step(
+    MineSweeperHintState* state,
+    const MineSweeperBoard* board,
+    uint32_t max_work_units);
+
+/* A tile the player can be sure of but hasn't opened or flagged, if one is
+ * known: safe tiles first, then mines, each the nearest to (x, y). */
+bool hint_sure_tile(
+    MineSweeperHintState* state,
+    const MineSweeperBoard* board,
+    uint8_t x,
+    uint8_t y,
+    uint16_t* tile,
+    bool* mine);
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+#endif // MINE_SWEEPER_HINT_H
@@ -1,186 +1,1258 @@
 #include "mine_sweeper_solver.h"
 #include "mine_sweeper_engine.h"
+#include "mstarlib_helpers.h"
 #include <furi.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
 
-bool check_board_with_solver(MineSweeperBoard* board) {
-    furi_assert(board);
+// Pair deduction looks at numbers up to this many tiles apart on either axis,
+// the furthest two numbers can be and still share a hidden neighbor.
+#define SOLVER_PAIR_REACH (2)
+// Hidden tiles of a pair are kept as bits of a square window around the first
+// number, wide enough to hold the second number's neighbors too.
+#define SOLVER_PAIR_WINDOW_HALF (SOLVER_PAIR_REACH + 1)
+#define SOLVER_PAIR_WINDOW      (2 * SOLVER_PAIR_WINDOW_HALF + 1)
+
+// Boards seen by solver_prefilter, per result.
+static atomic_uint_fast32_t solver_prefilter_seen[MineSweeperPrefilterCount];
+
+// Where the elimination stage is in its current window of the frontier.
+typedef enum {
+    SolverGaussGather = 0,
+    SolverGaussEliminate,
+    SolverGaussConclude,
+    SolverGaussDone, // no window of the frontier gave anything since the last progress
+} SolverGaussStage;
+
+static inline bool solver_bit(const uint32_t* rows, const MineSweeperBoard* board, uint16_t i) {
+    return ((rows[i / board->width] >> (i % board->width)) & 1u) != 0u;
+}
+
+static inline void solver_bit_set(uint32_t* rows, const MineSweeperBoard* board, uint16_t i) {
+    rows[i / board->width] |= 1u << (i % board->width);
+}
+
+static inline bool solver_is_revealed(
+    const MineSweeperSolverState* state,
+    const MineSweeperBoard* board,
+    uint16_t i) {
+    return solver_bit(state->revealed, board, i);
+}
+
+static inline bool solver_is_flagged(
+    const MineSweeperSolverState* state,
+    const MineSweeperBoard* board,
+    uint16_t i) {
+    return solver_bit(state->flagged, board, i);
+}
 
-    point_deq_t deq;
-    uint8_t visited[(BOARD_MAX_TILES + 7u) / 8u];
+static inline void solver_queue_push(uint16_t* ring, uint16_t* head, uint16_t* count, uint16_t i) {
+    furi_assert(*count < BOARD_MAX_TILES);
+    ring[(uint16_t)(*head + *count) % BOARD_MAX_TILES] = i;
+    (*count)++;
+}
 
-    point_deq_init(deq);
-    point_visited_clear(visited, (uint16_t)board->width * board->height);
+static inline uint16_t solver_queue_pop(const uint16_t* ring, uint16_t* head, uint16_t* count) {
+    furi_assert(*count > 0);
+    const uint16_t i = ring[*head];
+    *head = (uint16_t)(*head + 1u) % BOARD_MAX_TILES;
+    (*count)--;
+    return i;
+}
 
-    uint16_t total_mines = board->mine_count;
-    bool is_solvable = false;
-    bool has_invalid_flag_deduction = false;
+// Fills out with the indices of the tiles around i and returns how many there are.
+static uint8_t solver_neighbors(const MineSweeperBoard* board, uint16_t i, uint16_t out[8]) {
+    const uint8_t width = board->width;
+    const uint8_t x = (uint8_t)(i % width);
+    const uint8_t y = (uint8_t)(i / width);
+    uint8_t count = 0;
 
-    Point_t pos;
-    pointobj_init(pos);
+    for (uint8_t n = 0; n < 8; ++n) {
+        const int16_t dx = (int16_t)x + neighbor_offsets[n][0];
+        const int16_t dy = (int16_t)y + neighbor_offsets[n][1];
 
-    pointobj_set_point(pos, (Point){.x = 0, .y = 0});
+        if (dx < 0 || dy < 0 || dx >= width || dy >= board->height) continue;
 
-    bfs_tile_clear_solver(board, 0, 0, &deq, visited);
+        out[count++] = (uint16_t)(dy * width + dx);
+    }
 
-    while (!is_solvable && !has_invalid_flag_deduction && point_deq_size(deq) > 0) {
-        bool is_stuck = true;
+    return count;
+}
 
-        int16_t deq_size = point_deq_size(deq);
+// A tile was revealed or flagged, so the pair scan, the elimination and the
+// endgame count have to start over before the board can be called stuck.
+static inline void solver_note_progress(MineSweeperSolverState* state) {
+    state->pair_scanned = 0;
+    state->endgame_cursor = 0;
+    state->gauss_stage = SolverGaussGather;
+    state->gauss_start = 0;
+    state->gauss_next = 0;
+    state->gauss_row_count = 0;
+    state->gauss_column_count = 0;
+    state->gauss_rank = 0;
+    state->gauss_column = 0;
+}
 
-        while (deq_size-- > 0) {
-            point_deq_pop_front(&pos, deq);
-            const Point curr_pos = pointobj_get_point(pos);
-            uint16_t curr_pos_1d = board_index(board, curr_pos.x, curr_pos.y);
+// Queues a tile for flood reveal. Tiles are marked visited on push so each one
+// enters the flood queue at most once and the ring can never overflow.
+static void solver_flood_push(MineSweeperSolverState* state, uint16_t i) {
+    if (point_visited_test(state->visited, i)) return;
 
-            const MineSweeperCell cell = board->cells[curr_pos_1d];
-            uint8_t tile_number = CELL_GET_NEIGHBORS(cell);
-            uint8_t hidden_neighbors = 0;
-            uint8_t flagged_neighbors = 0;
+    point_visited_set(state->visited, i);
+    solver_queue_push(state->flood, &state->flood_head, &state->flood_count, i);
+}
 
-            if (!tile_number) continue;
+// Queues a numbered tile for another look unless it is already waiting.
+static void solver_edge_push(MineSweeperSolverState* state, uint16_t i) {
+    if (point_visited_test(state->queued, i)) return;
 
-            for (uint8_t n = 0; n < 8; ++n) {
-                const int16_t dx = curr_pos.x + neighbor_offsets[n][0];
-                const int16_t dy = curr_pos.y + neighbor_offsets[n][1];
+    point_visited_set(state->queued, i);
+    solver_queue_push(state->edges, &state->edges_head, &state->edges_count, i);
+}
 
-                if (!board_in_bounds(board, dx, dy)) {
-                    continue;
-                }
+// Tile i was just revealed or flagged: the numbers around it see one hidden
+// tile fewer, so only they can have become decidable. When spread is set (i is
+// a revealed zero) its hidden neighbors are flooded in the same pass.
+static void solver_touch_neighbors(
+    MineSweeperSolverState* state,
+    const MineSweeperBoard* board,
+    uint16_t i,
+    bool spread) {
+    uint16_t neighbors[8];
+    const uint8_t neighbor_count = solver_neighbors(board, i, neighbors);
 
-                const int16_t neighbor_pos_1d = board_index(board, dx, dy);
-                const MineSweeperCell neighbor_cell = board->cells[neighbor_pos_1d];
+    for (uint8_t n = 0; n < neighbor_count; ++n) {
+        if (!solver_is_revealed(state, board, neighbors[n])) {
+            if (spread) solver_flood_push(state, neighbors[n]);
+        } else if (CELL_GET_NEIGHBORS(board->cells[neighbors[n]])) {
+            solver_edge_push(state, neighbors[n]);
+        }
+    }
+}
+
+// One flood unit: reveal a tile, queue the numbers it affects and spread from zeros.
+static void solver_flood_step(MineSweeperSolverState* state, const MineSweeperBoard* board) {
+    const uint16_t i = solver_queue_pop(state->flood, &state->flood_head, &state->flood_count);
+    const MineSweeperCell cell = board->cells[i];
+
+    if (solver_is_revealed(state, board, i) || solver_is_flagged(state, board, i) ||
+        CELL_IS_MINE(cell)) {
+        return;
+    }
+
+    solver_bit_set(state->revealed, board, i);
+    state->revealed_count++;
+    solver_note_progress(state);
+    solver_touch_neighbors(state, board, i, CELL_GET_NEIGHBORS(cell) == 0);
+
+    if (CELL_GET_NEIGHBORS(cell)) {
+        solver_edge_push(state, i);
+    }
+}
+
+// Flags a tile deduced to be a mine. Deductions only ever follow from the
+// numbers, so a flag on a safe tile means the board is inconsistent.
+static bool
+    solver_flag(MineSweeperSolverState* state, const MineSweeperBoard* board, uint16_t i) {
+    if (!CELL_IS_MINE(board->cells[i]) || state->mines_left == 0) {
+        state->phase = MineSweeperSolverPhaseStuck;
+        return false;
+    }
+
+    solver_bit_set(state->flagged, board, i);
+    state->mines_left--;
+    solver_note_progress(state);
+    solver_touch_neighbors(state, board, i, false);
+    return true;
+}
+
+// One worklist unit: apply the single-tile rules to the next queued number. A
+// number that can't be decided yet is dropped; it is queued again as soon as
+// a tile around it changes.
+static void solver_edge_step(MineSweeperSolverState* state, const MineSweeperBoard* board) {
+    const uint16_t i = solver_queue_pop(state->edges, &state->edges_head, &state->edges_count);
+
+    const uint8_t tile_number = CELL_GET_NEIGHBORS(board->cells[i]);
+    uint16_t neighbors[8];
+    const uint8_t neighbor_count = solver_neighbors(board, i, neighbors);
+    uint8_t hidden_neighbors = 0;
+    uint8_t flagged_neighbors = 0;
+
+    for (uint8_t n = 0; n < neighbor_count; ++n) {
+        if (solver_is_flagged(state, board, neighbors[n])) {
+            flagged_neighbors++;
+        } else if (!solver_is_revealed(state, board, neighbors[n])) {
+            hidden_neighbors++;
+        }
+    }
+
+    if (flagged_neighbors > tile_number) {
+        state->phase = MineSweeperSolverPhaseStuck;
+        return;
+    }
 
-                if (CELL_IS_FLAGGED(neighbor_cell)) {
-                    flagged_neighbors++;
-                } else if (!CELL_IS_REVEALED(neighbor_cell)) {
-                    hidden_neighbors++;
-                }
+    const uint8_t remaining_mines = tile_number - flagged_neighbors;
+
+    if (hidden_neighbors == 0 || (remaining_mines != 0 && hidden_neighbors != remaining_mines)) {
+        point_visited_clear_bit(state->queued, i);
+        return;
+    }
+
+    for (uint8_t n = 0; n < neighbor_count; ++n) {
+        const uint16_t neighbor_pos_1d = neighbors[n];
+
+        if (solver_is_revealed(state, board, neighbor_pos_1d) ||
+            solver_is_flagged(state, board, neighbor_pos_1d)) {
+            continue;
+        }
+
+        if (remaining_mines == 0) {
+            solver_flood_push(state, neighbor_pos_1d);
+            continue;
+        }
+
+        if (!solver_flag(state, board, neighbor_pos_1d)) return;
+    }
+
+    // Still marked while flagging, so the flags above don't queue this tile again.
+    point_visited_clear_bit(state->queued, i);
+
+    if (state->mines_left == 0) {
+        state->phase = MineSweeperSolverPhaseSolved;
+    }
+}
+
+static inline uint32_t solver_row_mask(const MineSweeperBoard* board) {
+    return board->width >= 32u ? UINT32_MAX : (1u << board->width) - 1u;
+}
+
+// Open numbers of row y with a hidden neighbor: the only tiles the pair scan
+// and the endgame count have anything to do with.
+static uint32_t solver_frontier_row(
+    const MineSweeperSolverState* state,
+    const MineSweeperBoard* board,
+    uint8_t y) {
+    const uint32_t row_mask = solver_row_mask(board);
+    uint32_t hidden = 0;
+
+    for (int16_t r = (int16_t)y - 1; r <= (int16_t)y + 1; ++r) {
+        if (r < 0 || r >= board->height) continue;
+        hidden |= ~(state->revealed[r] | state->flagged[r]) & row_mask;
+    }
+
+    const uint32_t numbered = state->numbers[0][y] | state->numbers[1][y] |
+                              state->numbers[2][y] | state->numbers[3][y];
+    return state->revealed[y] & numbered & (hidden | (hidden << 1) | (hidden >> 1));
+}
+
+// Hidden tiles around the number at (x, y) as bits of the pair window centred
+// on (cx, cy), and how many mines among them are still unflagged. False if
+// there is no open number there.
+static bool solver_pair_constraint(
+    const MineSweeperSolverState* state,
+    const MineSweeperBoard* board,
+    int16_t x,
+    int16_t y,
+    int16_t cx,
+    int16_t cy,
+    uint64_t* hidden_out,
+    uint8_t* remaining_out) {
+    if (x < 0 || y < 0 || x >= board->width || y >= board->height) return false;
+
+    const MineSweeperCell cell = board->cells[y * board->width + x];
+    if (!((state->revealed[y] >> x) & 1u) || !CELL_GET_NEIGHBORS(cell)) return false;
+
+    uint64_t hidden = 0;
+    uint8_t flagged = 0;
+
+    for (uint8_t n = 0; n < 8; ++n) {
+        const int16_t dx = x + neighbor_offsets[n][0];
+        const int16_t dy = y + neighbor_offsets[n][1];
+
+        if (dx < 0 || dy < 0 || dx >= board->width || dy >= board->height) continue;
+
+        if ((state->flagged[dy] >> dx) & 1u) {
+            flagged++;
+        } else if (!((state->revealed[dy] >> dx) & 1u)) {
+            const uint8_t bit = (uint8_t)((dy - cy + SOLVER_PAIR_WINDOW_HALF) * SOLVER_PAIR_WINDOW +
+                                          (dx - cx + SOLVER_PAIR_WINDOW_HALF));
+            hidden |= (uint64_t)1u << bit;
+        }
+    }
+
+    if (hidden == 0 || flagged > CELL_GET_NEIGHBORS(cell)) return false;
+
+    *hidden_out = hidden;
+    *remaining_out = CELL_GET_NEIGHBORS(cell) - flagged;
+    return true;
+}
+
+// Flags (mines) or reveals (!mines) every tile in bits of the window centred on (cx, cy).
+static bool solver_pair_apply(
+    MineSweeperSolverState* state,
+    const MineSweeperBoard* board,
+    int16_t cx,
+    int16_t cy,
+    uint64_t bits,
+    bool mines) {
+    while (bits) {
+        const uint8_t bit = (uint8_t)__builtin_ctzll(bits);
+        bits &= bits - 1u;
+
+        const int16_t x = cx + bit % SOLVER_PAIR_WINDOW - SOLVER_PAIR_WINDOW_HALF;
+        const int16_t y = cy + bit / SOLVER_PAIR_WINDOW - SOLVER_PAIR_WINDOW_HALF;
+        const uint16_t i = (uint16_t)(y * board->width + x);
+
+        if (!mines) {
+            solver_flood_push(state, i);
+        } else if (!solver_flag(state, board, i)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// One pair unit, run once the worklist is dry: compare the next tile's number
+// with every nearby number sharing hidden tiles with it. If a's surplus of
+// mines over b needs every tile only a sees, those are mines and the tiles
+// only b sees are safe (the 1-1 and 1-2 patterns; subsets are the case where
+// b sees nothing a doesn't). Checking each ordered pair covers both ways round.
+static void solver_pair_step(MineSweeperSolverState* state, const MineSweeperBoard* board) {
+    const uint16_t tile_count = (uint16_t)board->width * board->height;
+    uint16_t i = state->pair_cursor;
+
+    // Tiles off the frontier have nothing to compare, so whole stretches of
+    // them count as scanned at once.
+    for (;;) {
+        const uint8_t x = (uint8_t)(i % board->width);
+        const uint8_t y = (uint8_t)(i / board->width);
+        const uint32_t ahead = solver_frontier_row(state, board, y) & (UINT32_MAX << x);
+        const uint16_t skipped = ahead ? (uint16_t)(__builtin_ctz(ahead) - x) :
+                                         (uint16_t)(board->width - x);
+
+        if (state->pair_scanned + skipped >= tile_count) {
+            state->pair_scanned = tile_count;
+            return;
+        }
+
+        state->pair_scanned += skipped;
+        if (ahead) {
+            i = (uint16_t)(i + skipped);
+            break;
+        }
+        i = (uint16_t)((i + skipped) % tile_count);
+    }
+
+    state->pair_cursor = (uint16_t)((i + 1u) % tile_count);
+    state->pair_scanned++;
+
+    const int16_t ax = (int16_t)(i % board->width);
+    const int16_t ay = (int16_t)(i / board->width);
+    uint64_t a_hidden;
+    uint8_t a_remaining;
+
+    if (!solver_pair_constraint(state, board, ax, ay, ax, ay, &a_hidden, &a_remaining)) return;
+
+    for (int16_t oy = -SOLVER_PAIR_REACH; oy <= SOLVER_PAIR_REACH; ++oy) {
+        for (int16_t ox = -SOLVER_PAIR_REACH; ox <= SOLVER_PAIR_REACH; ++ox) {
+            uint64_t b_hidden;
+            uint8_t b_remaining;
+
+            if ((ox == 0 && oy == 0) ||
+                !solver_pair_constraint(
+                    state, board, ax + ox, ay + oy, ax, ay, &b_hidden, &b_remaining) ||
+                (a_hidden & b_hidden) == 0 || a_remaining < b_remaining) {
+                continue;
+            }
+
+            const uint64_t only_a = a_hidden & ~b_hidden;
+            const uint64_t only_b = b_hidden & ~a_hidden;
+
+            if (a_remaining - b_remaining != __builtin_popcountll(only_a) ||
+                (only_a | only_b) == 0) {
+                continue;
+            }
+
+            // Leaves the rest to the worklist, which the changes have just refilled.
+            if (solver_pair_apply(state, board, ax, ay, only_a, true)) {
+                solver_pair_apply(state, board, ax, ay, only_b, false);
+            }
+            solver_note_progress(state);
+            if (state->phase == MineSweeperSolverPhaseRunning && state->mines_left == 0) {
+                state->phase = MineSweeperSolverPhaseSolved;
+            }
+            return;
+        }
+    }
+}
+
+// Frontier elimination, run once a pair scan finds nothing. Every open number
+// with hidden neighbors is an equation: the sum of its hidden tiles (1 for a
+// mine) is its count of unflagged mines. A window of these equations is
+// row-reduced with integer arithmetic, one pivot per unit, which combines
+// numbers across any distance the window spans. Each reduced row is then read
+// for tiles whose value it forces: with the other tiles of the row free to
+// take whatever values reach its bounds, a tile that only fits one way is
+// decided. Windows overlap by a couple of rows so patterns across a seam are
+// seen whole by the next one.
+
+// Adds the equation of the open number at i, unless the window has no room for
+// it. Returns false when full.
+static bool solver_gauss_add_row(
+    MineSweeperSolverState* state,
+    const MineSweeperBoard* board,
+    uint16_t i) {
+    const uint8_t number = CELL_GET_NEIGHBORS(board->cells[i]);
+    uint16_t neighbors[8];
+    const uint8_t neighbor_count = solver_neighbors(board, i, neighbors);
+    uint8_t columns[8];
+    uint8_t hidden_count = 0;
+    uint8_t flagged = 0;
+    uint8_t column_count = state->gauss_column_count;
+
+    if (state->gauss_row_count >= SOLVER_GAUSS_MAX_ROWS) return false;
+
+    for (uint8_t n = 0; n < neighbor_count; ++n) {
+        if (solver_is_flagged(state, board, neighbors[n])) {
+            flagged++;
+            continue;
+        }
+        if (solver_is_revealed(state, board, neighbors[n])) continue;
+
+        uint8_t c = 0;
+        while (c < column_count && state->gauss_tiles[c] != neighbors[n]) {
+            c++;
+        }
+        if (c == column_count) {
+            if (column_count >= SOLVER_GAUSS_MAX_COLUMNS) return false;
+            state->gauss_tiles[column_count++] = neighbors[n];
+        }
+        columns[hidden_count++] = c;
+    }
+
+    // Inconsistent numbers are left for the other stages to report.
+    if (flagged > number) return true;
+
+    int8_t* row = state->gauss_matrix[state->gauss_row_count];
+    memset(row, 0, SOLVER_GAUSS_MAX_COLUMNS);
+    for (uint8_t n = 0; n < hidden_count; ++n) {
+        row[columns[n]] = 1;
+    }
+
+    state->gauss_mines[state->gauss_row_count++] = (int8_t)(number - flagged);
+    state->gauss_column_count = column_count;
+    return true;
+}
+
+// One gather unit: add the frontier numbers of the next board row to the window.
+static void solver_gauss_gather(MineSweeperSolverState* state, const MineSweeperBoard* board) {
+    const uint16_t tile_count = (uint16_t)board->width * board->height;
+    const uint8_t y = (uint8_t)(state->gauss_next / board->width);
+    uint32_t frontier = solver_frontier_row(state, board, y) &
+                        (UINT32_MAX << (state->gauss_next % board->width));
+
+    while (frontier) {
+        const uint16_t i = (uint16_t)(y * board->width + __builtin_ctz(frontier));
+        frontier &= frontier - 1u;
+
+        if (!solver_gauss_add_row(state, board, i)) {
+            state->gauss_next = i;
+            state->gauss_stage = SolverGaussEliminate;
+            return;
+        }
+    }
+
+    state->gauss_next = (uint16_t)((y + 1u) * board->width);
+    if (state->gauss_next >= tile_count) {
+        state->gauss_stage = SolverGaussEliminate;
+    }
+}
+
+static int16_t solver_gcd(int16_t a, int16_t b) {
+    a = (int16_t)abs(a);
+    b = (int16_t)abs(b);
+    while (b != 0) {
+        const int16_t t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+// Cancels column c of row r against pivot row p: r = r * p[c] - p * r[c],
+// divided through by the common factor. A row whose coefficients outgrow
+// int8_t is dropped, which only costs deductions, never correctness.
+static void solver_gauss_combine(MineSweeperSolverState* state, uint8_t r, uint8_t p, uint8_t c) {
+    int8_t* row = state->gauss_matrix[r];
+    const int8_t* pivot = state->gauss_matrix[p];
+    const int16_t row_scale = pivot[c];
+    const int16_t pivot_scale = row[c];
+    int16_t combined[SOLVER_GAUSS_MAX_COLUMNS + 1];
+    int16_t divisor = 0;
+
+    for (uint8_t j = 0; j <= state->gauss_column_count; ++j) {
+        const int16_t a = j < state->gauss_column_count ? row[j] : state->gauss_mines[r];
+        const int16_t b = j < state->gauss_column_count ? pivot[j] : state->gauss_mines[p];
+        combined[j] = (int16_t)(a * row_scale - b * pivot_scale);
+        if (divisor != 1 && combined[j] != 0) divisor = solver_gcd(divisor, combined[j]);
+    }
+
+    bool fits = true;
+    for (uint8_t j = 0; j <= state->gauss_column_count; ++j) {
+        if (divisor > 1) combined[j] /= divisor;
+        fits = fits && combined[j] >= INT8_MIN && combined[j] <= INT8_MAX;
+    }
+
+    for (uint8_t j = 0; j < state->gauss_column_count; ++j) {
+        row[j] = fits ? (int8_t)combined[j] : 0;
+    }
+    state->gauss_mines[r] = fits ? (int8_t)combined[state->gauss_column_count] : 0;
+}
+
+// One elimination unit: pivot on the next column that still has a nonzero
+// entry below the rows already pivoted, taking the smallest one to keep the
+// coefficients small.
+static void solver_gauss_eliminate(MineSweeperSolverState* state) {
+    while (state->gauss_column < state->gauss_column_count &&
+           state->gauss_rank < state->gauss_row_count) {
+        const uint8_t c = state->gauss_column++;
+        uint8_t best = state->gauss_row_count;
+
+        for (uint8_t r = state->gauss_rank; r < state->gauss_row_count; ++r) {
+            const int8_t v = state->gauss_matrix[r][c];
+            if (v != 0 &&
+                (best == state->gauss_row_count || abs(v) < abs(state->gauss_matrix[best][c]))) {
+                best = r;
             }
+        }
+        if (best == state->gauss_row_count) continue;
+
+        const uint8_t p = state->gauss_rank++;
+        if (best != p) {
+            int8_t swap[SOLVER_GAUSS_MAX_COLUMNS];
+            memcpy(swap, state->gauss_matrix[p], sizeof(swap));
+            memcpy(state->gauss_matrix[p], state->gauss_matrix[best], sizeof(swap));
+            memcpy(state->gauss_matrix[best], swap, sizeof(swap));
 
-            if (flagged_neighbors > tile_number) {
-                has_invalid_flag_deduction = true;
-                break;
+            const int8_t mines = state->gauss_mines[p];
+            state->gauss_mines[p] = state->gauss_mines[best];
+            state->gauss_mines[best] = mines;
+        }
+
+        for (uint8_t r = 0; r < state->gauss_row_count; ++r) {
+            if (r != p && state->gauss_matrix[r][c] != 0) {
+                solver_gauss_combine(state, r, p, c);
             }
+        }
+        return;
+    }
+
+    state->gauss_stage = SolverGaussConclude;
+}
+
+// One conclusion unit: read every reduced row for forced tiles and apply them,
+// or move on to the next window if there are none.
+static void solver_gauss_conclude(MineSweeperSolverState* state, const MineSweeperBoard* board) {
+    uint64_t mines = 0;
+    uint64_t safe = 0;
+
+    for (uint8_t r = 0; r < state->gauss_row_count; ++r) {
+        const int8_t* row = state->gauss_matrix[r];
+        const int16_t target = state->gauss_mines[r];
+        int16_t low = 0;
+        int16_t high = 0;
+
+        for (uint8_t c = 0; c < state->gauss_column_count; ++c) {
+            if (row[c] < 0) low += row[c];
+            if (row[c] > 0) high += row[c];
+        }
+
+        if (target < low || target > high) {
+            state->phase = MineSweeperSolverPhaseStuck;
+            return;
+        }
+        for (uint8_t c = 0; c < state->gauss_column_count; ++c) {
+            const int16_t a = row[c];
+            if (a == 0) continue;
+
+            // Range the rest of the row can reach without this tile.
+            const int16_t rest_low = low - (a < 0 ? a : 0);
+            const int16_t rest_high = high - (a > 0 ? a : 0);
+            const bool can_be_safe = target >= rest_low && target <= rest_high;
+            const bool can_be_mine = target - a >= rest_low && target - a <= rest_high;
+
+            if (can_be_safe && !can_be_mine) safe |= (uint64_t)1u << c;
+            if (can_be_mine && !can_be_safe) mines |= (uint64_t)1u << c;
+        }
+    }
+
+    if ((mines | safe) == 0) {
+        const uint16_t tile_count = (uint16_t)board->width * board->height;
+        if (state->gauss_next >= tile_count) {
+            state->gauss_stage = SolverGaussDone;
+            return;
+        }
+
+        // The next window starts a couple of rows back, unless that would not move it on.
+        const uint16_t row = state->gauss_next / board->width;
+        const uint16_t overlap =
+            row > SOLVER_PAIR_REACH ? (uint16_t)((row - SOLVER_PAIR_REACH) * board->width) : 0u;
+        state->gauss_start = overlap > state->gauss_start ? overlap : state->gauss_next;
+        state->gauss_next = state->gauss_start;
+        state->gauss_row_count = 0;
+        state->gauss_column_count = 0;
+        state->gauss_rank = 0;
+        state->gauss_column = 0;
+        state->gauss_stage = SolverGaussGather;
+        return;
+    }
 
-            const uint8_t remaining_mines = tile_number - flagged_neighbors;
+    // Flagging resets the window, so the tiles are read out of it first.
+    uint16_t tiles[SOLVER_GAUSS_MAX_COLUMNS];
+    const uint8_t column_count = state->gauss_column_count;
+    memcpy(tiles, state->gauss_tiles, sizeof(tiles));
 
-            if (remaining_mines == 0) {
-                for (uint8_t n = 0; n < 8; ++n) {
-                    const int16_t dx = curr_pos.x + neighbor_offsets[n][0];
-                    const int16_t dy = curr_pos.y + neighbor_offsets[n][1];
+    for (uint8_t c = 0; c < column_count; ++c) {
+        if ((mines >> c) & 1u) {
+            if (!solver_flag(state, board, tiles[c])) return;
+        } else if ((safe >> c) & 1u) {
+            solver_flood_push(state, tiles[c]);
+        }
+    }
 
-                    if (!board_in_bounds(board, dx, dy)) continue;
+    solver_note_progress(state);
+    if (state->mines_left == 0) {
+        state->phase = MineSweeperSolverPhaseSolved;
+    }
+}
 
-                    const int16_t neighbor_pos_1d = board_index(board, dx, dy);
-                    const MineSweeperCell neighbor_cell = board->cells[neighbor_pos_1d];
+static void solver_gauss_step(MineSweeperSolverState* state, const MineSweeperBoard* board) {
+    switch (state->gauss_stage) {
+    case SolverGaussGather:
+        solver_gauss_gather(state, board);
+        break;
+    case SolverGaussEliminate:
+        solver_gauss_eliminate(state);
+        break;
+    default:
+        solver_gauss_conclude(state, board);
+        break;
+    }
+}
 
-                    if (!CELL_IS_REVEALED(neighbor_cell) && !CELL_IS_FLAGGED(neighbor_cell)) {
-                        bfs_tile_clear_solver(board, dx, dy, &deq, visited);
-                    }
-                }
+// Flags every hidden tile that is not in keep.
+static void solver_endgame_flag_all(
+    MineSweeperSolverState* state,
+    const MineSweeperBoard* board,
+    const uint8_t* keep) {
+    const uint16_t tile_count = (uint16_t)board->width * board->height;
 
-                is_stuck = false;
+    for (uint16_t i = 0; i < tile_count && state->phase == MineSweeperSolverPhaseRunning; ++i) {
+        if (solver_is_revealed(state, board, i) || solver_is_flagged(state, board, i)) continue;
+        if (keep && point_visited_test(keep, i)) continue;
 
-            } else if (hidden_neighbors == remaining_mines) {
-                for (uint8_t n = 0; n < 8; ++n) {
-                    const int16_t dx = curr_pos.x + neighbor_offsets[n][0];
-                    const int16_t dy = curr_pos.y + neighbor_offsets[n][1];
+        solver_flag(state, board, i);
+    }
+}
 
-                    if (!board_in_bounds(board, dx, dy)) continue;
+// Queues every hidden tile that is not in keep for reveal.
+static void solver_endgame_reveal_all(
+    MineSweeperSolverState* state,
+    const MineSweeperBoard* board,
+    const uint8_t* keep) {
+    const uint16_t tile_count = (uint16_t)board->width * board->height;
 
-                    const int16_t neighbor_pos_1d = board_index(board, dx, dy);
-                    const MineSweeperCell neighbor_cell = board->cells[neighbor_pos_1d];
+    for (uint16_t i = 0; i < tile_count; ++i) {
+        if (solver_is_revealed(state, board, i) || solver_is_flagged(state, board, i)) continue;
+        if (point_visited_test(keep, i)) continue;
 
-                    if (!CELL_IS_REVEALED(neighbor_cell) && !CELL_IS_FLAGGED(neighbor_cell)) {
-                        if (!CELL_IS_MINE(neighbor_cell) || total_mines == 0) {
-                            has_invalid_flag_deduction = true;
-                            break;
-                        }
+        solver_flood_push(state, i);
+    }
+}
 
-                        CELL_SET_FLAGGED(board->cells[neighbor_pos_1d]);
-                        total_mines--;
-                    }
-                }
+// Weighs the counts once every tile has been looked at. Numbers with disjoint
+// hidden tiles need at least lower mines between them and numbers covering the
+// whole frontier at most upper, so:
+//  - every hidden tile is a mine when that is all the mines left,
+//  - the tiles outside the disjoint numbers are safe when they need every mine left,
+//  - the interior is all mines when even a full frontier leaves that many over.
+// Applying a rule walks the board once, which only happens at a real endgame.
+static void
+    solver_endgame_conclude(MineSweeperSolverState* state, const MineSweeperBoard* board) {
+    const uint16_t interior = state->endgame_hidden - state->endgame_frontier;
 
-                if (has_invalid_flag_deduction) break;
+    if (state->endgame_lower > state->mines_left ||
+        state->endgame_upper + interior < state->mines_left) {
+        state->phase = MineSweeperSolverPhaseStuck;
+    } else if (state->endgame_hidden == state->mines_left) {
+        solver_endgame_flag_all(state, board, NULL);
+    } else if (
+        state->endgame_lower == state->mines_left &&
+        state->endgame_disjoint_tiles < state->endgame_hidden) {
+        solver_endgame_reveal_all(state, board, state->endgame_disjoint);
+    } else if (interior > 0 && state->endgame_upper + interior == state->mines_left) {
+        solver_endgame_flag_all(state, board, state->endgame_cover);
+    } else {
+        state->phase = MineSweeperSolverPhaseStuck;
+    }
 
-                if (total_mines == 0) is_solvable = true;
+    if (state->phase == MineSweeperSolverPhaseRunning && state->mines_left == 0) {
+        state->phase = MineSweeperSolverPhaseSolved;
+    }
+}
 
-                is_stuck = false;
+// One endgame unit, run once a pair scan finds nothing: count the next row's
+// hidden tiles towards the total, and let each of its frontier numbers claim
+// its hidden tiles for the lower (disjoint numbers only) and upper (any number
+// adding new tiles) bounds on the mines the frontier can hold.
+static void solver_endgame_step(MineSweeperSolverState* state, const MineSweeperBoard* board) {
+    const uint16_t tile_count = (uint16_t)board->width * board->height;
+    const uint8_t y = (uint8_t)state->endgame_cursor++;
 
-            } else if (hidden_neighbors != 0) {
-                point_deq_push_back(deq, pos);
+    if (y == 0) {
+        point_visited_clear(state->endgame_disjoint, tile_count);
+        point_visited_clear(state->endgame_cover, tile_count);
+        state->endgame_hidden = 0;
+        state->endgame_frontier = 0;
+        state->endgame_disjoint_tiles = 0;
+        state->endgame_lower = 0;
+        state->endgame_upper = 0;
+    }
+
+    state->endgame_hidden += (uint16_t)__builtin_popcount(
+        ~(state->revealed[y] | state->flagged[y]) & solver_row_mask(board));
+
+    uint32_t frontier = solver_frontier_row(state, board, y);
+    while (frontier) {
+        const uint16_t i = (uint16_t)(y * board->width + __builtin_ctz(frontier));
+        frontier &= frontier - 1u;
+
+        const uint8_t number = CELL_GET_NEIGHBORS(board->cells[i]);
+        uint16_t neighbors[8];
+        const uint8_t neighbor_count = solver_neighbors(board, i, neighbors);
+        uint16_t hidden[8];
+        uint8_t hidden_count = 0;
+        uint8_t flagged = 0;
+        bool disjoint = true;
+        bool adds_cover = false;
+
+        for (uint8_t n = 0; n < neighbor_count; ++n) {
+            if (solver_is_flagged(state, board, neighbors[n])) {
+                flagged++;
+            } else if (!solver_is_revealed(state, board, neighbors[n])) {
+                hidden[hidden_count++] = neighbors[n];
+                disjoint = disjoint && !point_visited_test(state->endgame_disjoint, neighbors[n]);
+                adds_cover = adds_cover || !point_visited_test(state->endgame_cover, neighbors[n]);
+            }
+        }
+
+        if (flagged > number) continue;
+
+        const uint8_t remaining = number - flagged;
+
+        for (uint8_t n = 0; n < hidden_count; ++n) {
+            if (disjoint) {
+                point_visited_set(state->endgame_disjoint, hidden[n]);
+            }
+            if (!point_visited_test(state->endgame_cover, hidden[n])) {
+                point_visited_set(state->endgame_cover, hidden[n]);
+                state->endgame_frontier++;
             }
         }
 
-        if (is_stuck) break;
+        if (disjoint) {
+            state->endgame_lower += remaining;
+            state->endgame_disjoint_tiles += hidden_count;
+        }
+        if (adds_cover) {
+            state->endgame_upper += remaining;
+        }
     }
 
-    point_deq_clear(deq);
+    if (state->endgame_cursor >= board->height) {
+        solver_endgame_conclude(state, board);
+    }
+}
+
+// Adds up, for every tile of a row at once, how many of its 8 neighbors are
+// set in rows (the row above, the row itself and the row below). The count
+// comes out bit-sliced: bit x of planes[k] is bit k of tile x's count.
+static void solver_rows_count(const uint32_t rows[3], uint32_t row_mask, uint32_t planes[4]) {
+    const uint32_t a0 = (rows[0] << 1) & row_mask;
+    const uint32_t a1 = rows[0];
+    const uint32_t a2 = rows[0] >> 1;
+    const uint32_t a3 = (rows[1] << 1) & row_mask;
+    const uint32_t a4 = rows[1] >> 1;
+    const uint32_t a5 = (rows[2] << 1) & row_mask;
+    const uint32_t a6 = rows[2];
+    const uint32_t a7 = rows[2] >> 1;
+
+    // Carry-save adders: three groups of ones, then their carries as twos.
+    const uint32_t s0 = a0 ^ a1 ^ a2;
+    const uint32_t c0 = (a0 & a1) | (a2 & (a0 ^ a1));
+    const uint32_t s1 = a3 ^ a4 ^ a5;
+    const uint32_t c1 = (a3 & a4) | (a5 & (a3 ^ a4));
+    const uint32_t s2 = a6 ^ a7;
+    const uint32_t c2 = a6 & a7;
+
+    const uint32_t c3 = (s0 & s1) | (s2 & (s0 ^ s1));
+    const uint32_t t0 = c0 ^ c1 ^ c2;
+    const uint32_t c4 = (c0 & c1) | (c2 & (c0 ^ c1));
+    const uint32_t c5 = t0 & c3;
+
+    planes[0] = s0 ^ s1 ^ s2;
+    planes[1] = t0 ^ c3;
+    planes[2] = c4 ^ c5;
+    planes[3] = c4 & c5;
+}
 
-    return is_solvable;
+// Tiles of a row whose bit-sliced values a and b are equal.
+static inline uint32_t solver_rows_equal(const uint32_t a[4], const uint32_t b[4]) {
+    return ~((a[0] ^ b[0]) | (a[1] ^ b[1]) | (a[2] ^ b[2]) | (a[3] ^ b[3]));
 }
 
-void bfs_tile_clear_solver(
-    MineSweeperBoard* board,
-    uint16_t x,
-    uint16_t y,
-    point_deq_t* edges,
-    uint8_t* visited) {
+// One row unit: apply the single-tile rules to every open number of row y at
+// once. Numbers that already see all their mines clear their hidden
+// neighbors, which also floods openings; numbers with exactly as many hidden
+// neighbors as mines left flag them. Rows around a change are marked for
+// another look, so the stage settles without full-board sweeps.
+static void solver_rows_step(MineSweeperSolverState* state, const MineSweeperBoard* board) {
+    const uint32_t row_mask = solver_row_mask(board);
+    const uint32_t all_rows = board->height >= 32u ? UINT32_MAX : (1u << board->height) - 1u;
+
+    // Round-robin over the marked rows, so one busy corner can't starve the rest.
+    const uint32_t ahead =
+        state->rows_cursor < 32u ? state->rows_dirty & (UINT32_MAX << state->rows_cursor) : 0u;
+    const uint8_t y = (uint8_t)__builtin_ctz(ahead ? ahead : state->rows_dirty);
+    state->rows_dirty &= ~(1u << y);
+    state->rows_cursor = (uint8_t)(y + 1u);
+
+    uint32_t hidden[3] = {0};
+    uint32_t flagged[3] = {0};
+    for (uint8_t k = 0; k < 3; ++k) {
+        const int16_t r = (int16_t)y + k - 1;
+        if (r < 0 || r >= board->height) continue;
+
+        hidden[k] = ~(state->revealed[r] | state->flagged[r]) & row_mask;
+        flagged[k] = state->flagged[r];
+    }
+
+    uint32_t hidden_count[4];
+    uint32_t flagged_count[4];
+    solver_rows_count(hidden, row_mask, hidden_count);
+    solver_rows_count(flagged, row_mask, flagged_count);
+
+    // hidden + flagged, bit-sliced; a carry out of the top plane can't match any number.
+    uint32_t sum[4];
+    uint32_t carry = 0;
+    for (uint8_t k = 0; k < 4; ++k) {
+        sum[k] = hidden_count[k] ^ flagged_count[k] ^ carry;
+        carry = (hidden_count[k] & flagged_count[k]) |
+                (carry & (hidden_count[k] ^ flagged_count[k]));
+    }
+
+    const uint32_t number[4] = {
+        state->numbers[0][y],
+        state->numbers[1][y],
+        state->numbers[2][y],
+        state->numbers[3][y],
+    };
+    const uint32_t open = state->revealed[y] &
+                          (hidden_count[0] | hidden_count[1] | hidden_count[2] | hidden_count[3]);
+    const uint32_t all_flagged = solver_rows_equal(flagged_count, number);
+    const uint32_t safe_source = open & all_flagged;
+    const uint32_t mine_source = open & ~all_flagged & ~carry & solver_rows_equal(sum, number);
+
+    if ((safe_source | mine_source) == 0) return;
+
+    const uint32_t safe_reach = (safe_source | (safe_source << 1) | (safe_source >> 1)) & row_mask;
+    const uint32_t mine_reach = (mine_source | (mine_source << 1) | (mine_source >> 1)) & row_mask;
+    uint32_t changed_rows = 0;
+
+    for (uint8_t k = 0; k < 3; ++k) {
+        const int16_t r = (int16_t)y + k - 1;
+        if (r < 0 || r >= board->height) continue;
+
+        const uint32_t new_safe = safe_reach & hidden[k];
+        const uint32_t new_mines = mine_reach & hidden[k];
+        if ((new_safe | new_mines) == 0) continue;
+
+        // Deductions only ever follow from the numbers, so these mean an inconsistent board.
+        if ((new_safe & state->mines[r]) || (new_mines & ~state->mines[r]) ||
+            (new_safe & new_mines)) {
+            state->phase = MineSweeperSolverPhaseStuck;
+            return;
+        }
+
+        state->revealed[r] |= new_safe;
+        state->revealed_count += (uint16_t)__builtin_popcount(new_safe);
+        state->flagged[r] |= new_mines;
+        state->mines_left -= (uint16_t)__builtin_popcount(new_mines);
+        changed_rows |= 1u << r;
+    }
+
+    state->rows_dirty |= (changed_rows | (changed_rows << 1) | (changed_rows >> 1)) & all_rows;
+
+    if (state->mines_left == 0) {
+        state->phase = MineSweeperSolverPhaseSolved;
+    }
+}
+
+// Every tile's number is its count of neighboring mines, so the planes can
+// be built row by row the same way the row stage counts.
+static void solver_number_row(
+    MineSweeperSolverState* state,
+    const MineSweeperBoard* board,
+    uint8_t y,
+    uint32_t row_mask) {
+    const uint32_t rows[3] = {
+        y > 0 ? state->mines[y - 1u] : 0u,
+        state->mines[y],
+        y + 1u < board->height ? state->mines[y + 1u] : 0u,
+    };
+    uint32_t planes[4];
+    solver_rows_count(rows, row_mask, planes);
+    for (uint8_t k = 0; k < 4; ++k) {
+        state->numbers[k][y] = planes[k] & ~state->mines[y];
+    }
+}
+
+void solver_begin_unopened(MineSweeperSolverState* state, const MineSweeperBoard* board) {
+    furi_assert(state);
     furi_assert(board);
-    furi_assert(edges);
-    furi_assert(visited);
 
-    point_deq_t deq;
-    point_deq_init(deq);
+    const uint16_t tile_count = (uint16_t)board->width * board->height;
+    const uint32_t row_mask = solver_row_mask(board);
 
-    Point_t pos;
-    pointobj_init(pos);
+    state->edges_head = 0;
+    state->edges_count = 0;
+    state->flood_head = 0;
+    state->flood_count = 0;
+    state->mines_left = board->mine_count;
+    point_visited_clear(state->visited, tile_count);
+    point_visited_clear(state->queued, tile_count);
+    state->pair_cursor = 0;
+    solver_note_progress(state);
 
-    pointobj_set_point(pos, (Point){.x = x, .y = y});
+    memset(state->revealed, 0, sizeof(state->revealed));
+    memset(state->flagged, 0, sizeof(state->flagged));
+    memset(state->mines, 0, sizeof(state->mines));
+    for (uint16_t i = 0; i < tile_count; ++i) {
+        if (CELL_IS_MINE(board->cells[i])) solver_bit_set(state->mines, board, i);
+    }
 
-    point_deq_push_back(deq, pos);
+    for (uint8_t y = 0; y < board->height; ++y) {
+        solver_number_row(state, board, y, row_mask);
+    }
 
-    while (point_deq_size(deq) > 0) {
-        point_deq_pop_front(&pos, deq);
-        Point curr_pos = pointobj_get_point(pos);
-        uint16_t curr_pos_1d = board_index(board, curr_pos.x, curr_pos.y);
-        MineSweeperCell curr_cell = board->cells[curr_pos_1d];
+    state->revealed_count = 0;
+    state->rows_dirty = 0;
+    state->rows_cursor = 0;
+    state->phase = MineSweeperSolverPhaseRunning;
+}
 
-        if (point_visited_test(visited, curr_pos_1d) || CELL_IS_REVEALED(curr_cell) ||
-            CELL_IS_FLAGGED(curr_cell)) {
-            continue;
+void solver_begin(MineSweeperSolverState* state, const MineSweeperBoard* board) {
+    solver_begin_unopened(state, board);
+
+    // The opening tile is revealed up front and the row stage takes it from there.
+    if (!CELL_IS_MINE(board->cells[0])) {
+        state->revealed[0] = 1u;
+        state->revealed_count = 1;
+        point_visited_set(state->visited, 0);
+        state->rows_dirty = 1u;
+    }
+}
+
+void solver_reveal(MineSweeperSolverState* state, const MineSweeperBoard* board, uint16_t i) {
+    furi_assert(state);
+    furi_assert(board);
+
+    if (solver_is_revealed(state, board, i) || solver_is_flagged(state, board, i) ||
+        CELL_IS_MINE(board->cells[i])) {
+        return;
+    }
+
+    const uint32_t all_rows = board->height >= 32u ? UINT32_MAX : (1u << board->height) - 1u;
+    const uint32_t row = 1u << (i / board->width);
+
+    solver_bit_set(state->revealed, board, i);
+    state->revealed_count++;
+    point_visited_set(state->visited, i);
+    state->rows_dirty |= (row | (row << 1) | (row >> 1)) & all_rows;
+    solver_note_progress(state);
+    solver_touch_neighbors(state, board, i, false);
+    if (CELL_GET_NEIGHBORS(board->cells[i])) {
+        solver_edge_push(state, i);
+    }
+
+    if (state->phase == MineSweeperSolverPhaseStuck) {
+        state->phase = MineSweeperSolverPhaseRunning;
+    }
+}
+
+void solver_mines_moved(
+    MineSweeperSolverState* state,
+    const MineSweeperBoard* board,
+    uint32_t moved_rows) {
+    furi_assert(state);
+    furi_assert(board);
+
+    const uint32_t row_mask = solver_row_mask(board);
+    const uint32_t all_rows = board->height >= 32u ? UINT32_MAX : (1u << board->height) - 1u;
+    const uint32_t around = (moved_rows | (moved_rows << 1) | (moved_rows >> 1)) & all_rows;
+
+    for (uint8_t y = 0; y < board->height; ++y) {
+        if (!(moved_rows & (1u << y))) continue;
+
+        state->mines[y] = 0;
+        for (uint8_t x = 0; x < board->width; ++x) {
+            if (CELL_IS_MINE(board->cells[board_index(board, x, y)])) {
+                state->mines[y] |= 1u << x;
+            }
         }
+    }
+    for (uint8_t y = 0; y < board->height; ++y) {
+        if (around & (1u << y)) solver_number_row(state, board, y, row_mask);
+    }
 
-        point_visited_set(visited, curr_pos_1d);
+    // Only numbers around the moved mines changed, so only their rows need another look.
+    state->rows_dirty |= around;
+    solver_note_progress(state);
+    if (state->phase == MineSweeperSolverPhaseStuck) {
+        state->phase = MineSweeperSolverPhaseRunning;
+    }
+}
+
+uint16_t
+    solver_revealed_count(const MineSweeperSolverState* state, const MineSweeperBoard* board) {
+    furi_assert(state);
+    furi_assert(board);
+
+    return state->revealed_count;
+}
+
+MineSweeperSolverPhase solver_step(
+    MineSweeperSolverState* state,
+    const MineSweeperBoard* board,
+    uint32_t max_work_units) {
+    furi_assert(state);
+    furi_assert(board);
 
-        uint8_t neighbor_bomb_count = CELL_GET_NEIGHBORS(curr_cell);
+    for (uint32_t unit = 0; unit < max_work_units; ++unit) {
+        if (state->phase != MineSweeperSolverPhaseRunning) break;
 
-        if (CELL_IS_MINE(curr_cell)) {
+        // Whole rows at a time until the single-tile rules settle.
+        if (state->rows_dirty != 0) {
+            solver_rows_step(state, board);
             continue;
         }
 
-        CELL_SET_REVEALED(board->cells[curr_pos_1d]);
+        // Openings are expanded before the next edge tile, matching a recursive flood.
+        if (state->flood_count > 0) {
+            solver_flood_step(state, board);
+            continue;
+        }
 
-        if (neighbor_bomb_count) {
-            point_deq_push_back(*edges, pos);
+        if (state->edges_count > 0) {
+            solver_edge_step(state, board);
             continue;
         }
 
+        // The single-tile rules are out of moves: try pairs, then the whole
+        // frontier at once, then the mine total.
+        if (state->pair_scanned < (uint16_t)board->width * board->height) {
+            solver_pair_step(state, board);
+        } else if (state->gauss_stage != SolverGaussDone) {
+            solver_gauss_step(state, board);
+        } else {
+            solver_endgame_step(state, board);
+        }
+    }
+
+    return state->phase;
+}
+
+// Mine rows for the prefilter, shifted up one so that bit x + 1 is tile x,
+// with every tile off the board set: to the walls a tile only needs, off the
+// board counts the same as a mine.
+static inline uint64_t
+    solver_prefilter_wall(const uint64_t* walls, const MineSweeperBoard* board, int16_t y) {
+    return y < 0 || y >= board->height ? UINT64_MAX : walls[y];
+}
+
+// Bit x + 1 set where tile (x + dx, y) is a mine or off the board.
+static inline uint64_t solver_prefilter_at(
+    const uint64_t* walls,
+    const MineSweeperBoard* board,
+    int16_t y,
+    int8_t dx) {
+    const uint64_t row = solver_prefilter_wall(walls, board, y);
+    return dx >= 0 ? row >> dx : row << -dx;
+}
+
+// The start tile shows a number with hidden tiles around it and nothing else
+// is open, so only the endgame count could move on; true if it can't either.
+static bool solver_prefilter_start_stuck(const MineSweeperBoard* board) {
+    const uint8_t number = CELL_GET_NEIGHBORS(board->cells[0]);
+    if (number == 0) return false;
+
+    uint16_t neighbors[8];
+    const uint16_t around = solver_neighbors(board, 0, neighbors);
+    const uint16_t hidden = (uint16_t)board->width * board->height - 1u;
+    const uint16_t mines = board->mine_count;
+
+    if (number == around) {
+        // All flagged at once, leaving only the count over the rest.
+        return mines != around && mines != hidden;
+    }
+
+    return mines != hidden && mines != number &&
+           !(hidden > around && number + hidden - around == mines);
+}
+
+// Pockets are safe tiles, other than the start, with nothing but mines
+// around. A mine whose only safe neighbors are pockets can never be reached:
+// no number it touches is ever opened, and the pockets it walls in can't be
+// opened while it is unaccounted for.
+static bool solver_prefilter_sealed_pocket(const uint64_t* walls, const MineSweeperBoard* board) {
+    const uint64_t inside = (uint64_t)solver_row_mask(board) << 1;
+    uint64_t pockets[BOARD_MAX_HEIGHT];
+
+    for (int16_t y = 0; y < board->height; ++y) {
+        pockets[y] = ~walls[y];
         for (uint8_t n = 0; n < 8; ++n) {
-            const int16_t dx = curr_pos.x + neighbor_offsets[n][0];
-            const int16_t dy = curr_pos.y + neighbor_offsets[n][1];
+            pockets[y] &= solver_prefilter_at(
+                walls, board, y + neighbor_offsets[n][1], neighbor_offsets[n][0]);
+        }
+    }
+    pockets[0] &= ~(uint64_t)2u;
+
+    for (int16_t y = 0; y < board->height; ++y) {
+        uint64_t near_pocket = 0;
+        uint64_t near_open = 0;
+
+        for (int16_t r = y - 1; r <= y + 1; ++r) {
+            if (r < 0 || r >= board->height) continue;
+
+            const uint64_t open = ~walls[r] & ~pockets[r];
+            near_pocket |= pockets[r] | (pockets[r] << 1) | (pockets[r] >> 1);
+            near_open |= open | (open << 1) | (open >> 1);
+        }
+
+        if (walls[y] & inside & near_pocket & ~near_open) return true;
+    }
+
+    return false;
+}
+
+// A 50/50 is a mine a and a safe tile b next to each other where every other
+// tile touching just one of them is a mine. Swapping the two then changes no
+// number that can ever be opened, so nothing tells them apart, and a would
+// have to be flagged for the board to count as solved.
+#define SOLVER_PREFILTER_PAIR_COUNT (4u)
+
+typedef struct {
+    int8_t dx;
+    int8_t dy;
+    // Tiles around just one of a = (0, 0) and b = (dx, dy)
+    uint8_t wall_count;
+    int8_t walls[10][2];
+} SolverPrefilterPair;
+
+static const SolverPrefilterPair solver_prefilter_pairs[SOLVER_PREFILTER_PAIR_COUNT] = {
+    {1, 0, 6, {{-1, -1}, {-1, 0}, {-1, 1}, {2, -1}, {2, 0}, {2, 1}}},
+    {0, 1, 6, {{-1, -1}, {0, -1}, {1, -1}, {-1, 2}, {0, 2}, {1, 2}}},
+    {1,
+     1,
+     10,
+     {{-1, -1}, {0, -1}, {1, -1}, {-1, 0}, {-1, 1}, {2, 0}, {2, 1}, {0, 2}, {1, 2}, {2, 2}}},
+    {1,
+     -1,
+     10,
+     {{-1, -1}, {-1, 0}, {-1, 1}, {0, 1}, {1, 1}, {0, -2}, {1, -2}, {2, -2}, {2, -1}, {2, 0}}},
+};
+
+static bool solver_prefilter_fifty_fifty(const uint64_t* walls, const MineSweeperBoard* board) {
+    const uint64_t inside = (uint64_t)solver_row_mask(board) << 1;
+
+    for (int16_t y = 0; y < board->height; ++y) {
+        for (uint8_t d = 0; d < SOLVER_PREFILTER_PAIR_COUNT; ++d) {
+            const SolverPrefilterPair* pair = &solver_prefilter_pairs[d];
+            if (y + pair->dy < 0 || y + pair->dy >= board->height) continue;
+
+            // Bit x + 1 stands for a = (x, y) and b = (x + dx, y + dy).
+            const uint64_t b = solver_prefilter_at(walls, board, y + pair->dy, pair->dx);
+            uint64_t pairs = (walls[y] ^ b) & inside & (inside >> pair->dx);
+            // The start tile is opened up front, so it is never in doubt.
+            if (y == 0) pairs &= ~(uint64_t)2u;
+
+            for (uint8_t w = 0; w < pair->wall_count && pairs; ++w) {
+                pairs &= solver_prefilter_at(
+                    walls, board, y + pair->walls[w][1], pair->walls[w][0]);
+            }
+
+            if (pairs) return true;
+        }
+    }
 
-            if (!board_in_bounds(board, dx, dy)) continue;
+    return false;
+}
 
-            const uint16_t neighbor_pos_1d = board_index(board, (uint8_t)dx, (uint8_t)dy);
-            if (point_visited_test(visited, neighbor_pos_1d)) continue;
+MineSweeperPrefilterResult solver_prefilter(const MineSweeperBoard* board) {
+    furi_assert(board);
+
+    MineSweeperPrefilterResult result = MineSweeperPrefilterPass;
+    if (solver_prefilter_start_stuck(board)) {
+        result = MineSweeperPrefilterStartNumber;
+        atomic_fetch_add_explicit(&solver_prefilter_seen[result], 1u, memory_order_relaxed);
+        return result;
+    }
 
-            pointobj_set_point(pos, (Point){.x = (uint8_t)dx, .y = (uint8_t)dy});
+    const uint64_t outside = ~((uint64_t)solver_row_mask(board) << 1);
+    uint64_t walls[BOARD_MAX_HEIGHT];
 
-            point_deq_push_back(deq, pos);
+    for (uint8_t y = 0; y < board->height; ++y) {
+        uint64_t row = 0;
+        for (uint8_t x = 0; x < board->width; ++x) {
+            if (CELL_IS_MINE(board->cells[y * board->width + x])) row |= (uint64_t)2u << x;
         }
+        walls[y] = row | outside;
     }
 
-    point_deq_clear(deq);
+    if (solver_prefilter_sealed_pocket(walls, board)) {
+        result = MineSweeperPrefilterSealedPocket;
+    } else if (solver_prefilter_fifty_fifty(walls, board)) {
+        result = MineSweeperPrefilterFiftyFifty;
+    }
+
+    atomic_fetch_add_explicit(&solver_prefilter_seen[result], 1u, memory_order_relaxed);
+    return result;
+}
+
+void solver_prefilter_counts(uint32_t counts[MineSweeperPrefilterCount]) {
+    furi_assert(counts);
+
+    for (uint8_t i = 0; i < MineSweeperPrefilterCount; ++i) {
+        counts[i] =
+            (uint32_t)atomic_load_explicit(&solver_prefilter_seen[i], memory_order_relaxed);
+    }
+}
+
+bool check_board_with_solver(const MineSweeperBoard* board) {
+    furi_assert(board);
+
+    if (solver_prefilter(board) != MineSweeperPrefilterPass) {
+        return false;
+    }
+
+    MineSweeperSolverState* state = malloc(sizeof(MineSweeperSolverState));
+    furi_check(state);
+
+    solver_begin(state, board);
+    const MineSweeperSolverPhase phase = solver_step(state, board, UINT32_MAX);
+    free(state);
+
+    return phase == MineSweeperSolverPhaseSolved;
 }
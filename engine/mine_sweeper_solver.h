@@ -1,7 +1,6 @@
 #ifndef MINE_SWEEPER_SOLVER_H
 #define MINE_SWEEPER_SOLVER_H
 
-#include "mstarlib_helpers.h"
 #include "mine_sweeper_engine.h"
 #include <stdbool.h>
 
@@ -9,14 +8,83 @@
 extern "C" {
 #endif // __cplusplus
 
-bool check_board_with_solver(MineSweeperBoard* board);
+/* Resets the solver and opens (0,0). The board is only read, by this and by
+ * solver_step, so it needs no cleaning up afterwards. */
+void solver_begin(MineSweeperSolverState* state, const MineSweeperBoard* board);
 
-void bfs_tile_clear_solver(
-    MineSweeperBoard* board,
-    uint16_t x,
-    uint16_t y,
-    point_deq_t* edges,
-    uint8_t* visited);
+/* Resets the solver with nothing revealed, for following a game from outside:
+ * the tiles the player opens are then handed over with solver_reveal. */
+void solver_begin_unopened(MineSweeperSolverState* state, const MineSweeperBoard* board);
+
+/* Reveals tile i as if the solver had, for the rules to take on from there.
+ * Mines and tiles already decided are left alone. A stuck solver is running
+ * again afterwards. */
+void solver_reveal(MineSweeperSolverState* state, const MineSweeperBoard* board, uint16_t i);
+
+/* Mines were moved between undecided tiles of moved_rows (the board's neighbor
+ * counts already redone). Updates the solver's copy of the numbers and has it
+ * look again around them, carrying on from what it had decided. Deductions
+ * made before the move may have used numbers that changed, so a board solved
+ * this way still needs a fresh solve to be sure. */
+void solver_mines_moved(
+    MineSweeperSolverState* state,
+    const MineSweeperBoard* board,
+    uint32_t moved_rows);
+
+/* Runs at most max_work_units units and returns the phase reached. Running
+ * means call again to continue. The single-tile rules run first on whole rows
+ * of bitmasks (one unit per row), and only rows next to a change are looked at
+ * again. Once they settle, pairs of overlapping numbers are compared (one unit
+ * per tile), with the numbers around any new deduction rechecked one by one.
+ * Next the frontier's numbers are row-reduced as a linear system, a window of
+ * them at a time (one unit per board row gathered or pivot eliminated), and
+ * finally the frontier is weighed against the mines left. The board is stuck
+ * when none of these finds anything. */
+MineSweeperSolverPhase solver_step(
+    MineSweeperSolverState* state,
+    const MineSweeperBoard* board,
+    uint32_t max_work_units);
+
+/* Runs the solver to completion on a scratch state, after solver_prefilter. */
+bool check_board_with_solver(const MineSweeperBoard* board);
+
+/** Pre-solve rejection.
+  *
+  * A few layouts are hopeless for the solver in ways the mine bitmap shows
+  * at a glance, so candidates are checked for them in a few microseconds
+  * before the solver runs at all. Every reason is exact: a board rejected
+  * here is one the solver would also have got stuck on.
+  */
+typedef enum {
+    MineSweeperPrefilterPass = 0,
+    // The start tile is a number the first rules can do nothing with
+    MineSweeperPrefilterStartNumber,
+    // A safe tile walled in by mines, one of which no other tile touches
+    MineSweeperPrefilterSealedPocket,
+    // A mine and a safe tile next to each other that every number sees alike
+    MineSweeperPrefilterFiftyFifty,
+    MineSweeperPrefilterCount,
+} MineSweeperPrefilterResult;
+
+/* Checks a board with its neighbor counts computed, counting the result. */
+MineSweeperPrefilterResult solver_prefilter(const MineSweeperBoard* board);
+
+/* Boards seen by solver_prefilter so far, per result. Safe from any thread. */
+void solver_prefilter_counts(uint32_t counts[MineSweeperPrefilterCount]);
+
+/* How many tiles the solver has revealed so far. */
+uint16_t solver_revealed_count(const MineSweeperSolverState* state, const MineSweeperBoard* board);
+
+static inline bool
+    solver_tile_revealed(const MineSweeperSolverState* state, uint8_t x, uint8_t y) {
+    return ((state->revealed[y] >> x) & 1u) != 0u;
+}
+
+/* Neither revealed nor flagged by the solver yet. */
+static inline bool
+    solver_tile_undecided(const MineSweeperSolverState* state, uint8_t x, uint8_t y) {
+    return (((state->revealed[y] | state->flagged[y]) >> x) & 1u) == 0u;
+}
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,229 @@
+#include "mine_sweeper_strategy.h"
+#include "mine_sweeper_atlas.h"
+#include "mine_sweeper_generator.h"
+#include "mine_sweeper_solver.h"
+
+#include <furi.h>
+#include <furi_hal.h>
+#include <string.h>
+
+// Upper tile count of each size class, and the size calibrated for it.
+static const uint16_t strategy_class_max_tiles[MINESWEEPER_STRATEGY_SIZE_CLASSES] = {
+    160,
+    384,
+    640,
+    BOARD_MAX_TILES,
+};
+static const uint8_t strategy_class_size[MINESWEEPER_STRATEGY_SIZE_CLASSES][2] = {
+    {16, 8},
+    {20, 14},
+    {24, 22},
+    {30, 28},
+};
+
+// Per strategy and class: time spent before moving on, unless fewer attempts ran.
+#define CALIBRATION_BUDGET_US    (120u * 1000u)
+#define CALIBRATION_MIN_ATTEMPTS (3u)
+
+// Calibrated strategy + 1 per class, 0 where there is none.
+static atomic_uint_fast8_t strategy_tuning[MINESWEEPER_STRATEGY_CLASS_COUNT];
+
+static bool
+    strategy_place_random(MineSweeperBoard* board, uint16_t mine_count, uint16_t* cleared_out) {
+    board_generate_candidate(board, mine_count);
+    *cleared_out = 0;
+    return false;
+}
+
+static bool strategy_place_constructive(
+    MineSweeperBoard* board,
+    uint16_t mine_count,
+    uint16_t* cleared_out) {
+    return board_generate_constructive(board, mine_count, cleared_out);
+}
+
+static const MineSweeperStrategyOps strategy_ops[MineSweeperStrategyCount] = {
+    [MineSweeperStrategyRejection] =
+        {
+            .name = "rejection",
+            .self_verifying = false,
+            .place = strategy_place_random,
+        },
+    [MineSweeperStrategyConstructive] =
+        {
+            .name = "constructive",
+            .self_verifying = true,
+            .place = strategy_place_constructive,
+        },
+};
+
+const MineSweeperStrategyOps* minesweeper_strategy_ops(MineSweeperStrategy strategy) {
+    furi_check(strategy < MineSweeperStrategyCount);
+    return &strategy_ops[strategy];
+}
+
+uint8_t minesweeper_strategy_class(const MineSweeperConfig* config) {
+    furi_assert(config);
+
+    const uint8_t difficulty = config->difficulty >= MINESWEEPER_DIFFICULTY_COUNT ?
+                                   MINESWEEPER_DIFFICULTY_COUNT - 1 :
+                                   config->difficulty;
+    const uint16_t tiles = (uint16_t)config->width * config->height;
+
+    uint8_t size_class = 0;
+    while (size_class + 1u < MINESWEEPER_STRATEGY_SIZE_CLASSES &&
+           tiles > strategy_class_max_tiles[size_class]) {
+        size_class++;
+    }
+
+    return (uint8_t)(difficulty * MINESWEEPER_STRATEGY_SIZE_CLASSES + size_class);
+}
+
+MineSweeperStrategy minesweeper_strategy_pick(const MineSweeperConfig* config) {
+    furi_assert(config);
+
+    if (!config->ensure_solvable) {
+        return MineSweeperStrategyRejection;
+    }
+
+    const uint8_t tuned = atomic_load(&strategy_tuning[minesweeper_strategy_class(config)]);
+    if (tuned != 0) {
+        return (MineSweeperStrategy)(tuned - 1u);
+    }
+
+    MineSweeperAtlasEstimate estimate;
+    minesweeper_atlas_estimate(config->width, config->height, config->difficulty, &estimate);
+    return minesweeper_atlas_pick_strategy(&estimate);
+}
+
+void minesweeper_strategy_set_tuning(const uint8_t* per_class) {
+    furi_assert(per_class);
+
+    for (uint8_t i = 0; i < MINESWEEPER_STRATEGY_CLASS_COUNT; i++) {
+        atomic_store(
+            &strategy_tuning[i], per_class[i] < MineSweeperStrategyCount ? per_class[i] + 1u : 0u);
+    }
+}
+
+void minesweeper_strategy_get_tuning(uint8_t* per_class) {
+    furi_assert(per_class);
+
+    for (uint8_t i = 0; i < MINESWEEPER_STRATEGY_CLASS_COUNT; i++) {
+        const uint8_t tuned = atomic_load(&strategy_tuning[i]);
+        per_class[i] = tuned != 0 ? tuned - 1u : MineSweeperStrategyCount;
+    }
+}
+
+static MineSweeperConfig minesweeper_calibration_config(uint8_t class_index) {
+    const uint8_t size_class = class_index % MINESWEEPER_STRATEGY_SIZE_CLASSES;
+
+    return (MineSweeperConfig){
+        .width = strategy_class_size[size_class][0],
+        .height = strategy_class_size[size_class][1],
+        .difficulty = class_index / MINESWEEPER_STRATEGY_SIZE_CLASSES,
+        .ensure_solvable = true,
+    };
+}
+
+static inline uint32_t calibration_cycles_now(void) {
+    return furi_hal_cortex_timer_get(0).start;
+}
+
+static inline uint32_t calibration_cycles_to_us(uint32_t cycles) {
+    return cycles / furi_hal_cortex_instructions_per_microsecond();
+}
+
+// Settles the current class once every strategy has been timed.
+static void minesweeper_calibration_conclude_class(MineSweeperCalibration* calibration) {
+    const MineSweeperConfig config = minesweeper_calibration_config(calibration->class_index);
+
+    MineSweeperAtlasEstimate estimate;
+    minesweeper_atlas_estimate(config.width, config.height, config.difficulty, &estimate);
+    for (uint8_t s = 0; s < MineSweeperStrategyCount; s++) {
+        estimate.cost_us[s] = calibration->cost_us[s];
+    }
+
+    calibration->result[calibration->class_index] = minesweeper_atlas_pick_strategy(&estimate);
+    calibration->class_index++;
+    calibration->strategy = 0;
+    calibration->done = calibration->class_index >= MINESWEEPER_STRATEGY_CLASS_COUNT;
+}
+
+// Moves to the next strategy worth timing, settling classes that run out of them.
+static void minesweeper_calibration_advance(MineSweeperCalibration* calibration) {
+    while (!calibration->done) {
+        if (calibration->strategy >= MineSweeperStrategyCount) {
+            minesweeper_calibration_conclude_class(calibration);
+            continue;
+        }
+
+        const MineSweeperConfig config = minesweeper_calibration_config(calibration->class_index);
+        MineSweeperAtlasEstimate estimate;
+        minesweeper_atlas_estimate(config.width, config.height, config.difficulty, &estimate);
+
+        if (estimate.accept[calibration->strategy] > 0.0f) {
+            calibration->attempts = 0;
+            calibration->cycles = 0;
+            return;
+        }
+
+        calibration->cost_us[calibration->strategy] = 0.0f;
+        calibration->strategy++;
+    }
+}
+
+void minesweeper_calibration_begin(MineSweeperCalibration* calibration) {
+    furi_assert(calibration);
+
+    memset(calibration, 0, sizeof(*calibration));
+    minesweeper_calibration_advance(calibration);
+}
+
+bool minesweeper_calibration_step(MineSweeperCalibration* calibration, uint32_t budget_us) {
+    furi_assert(calibration);
+
+    const uint32_t slice_start = calibration_cycles_now();
+    bool attempted = false;
+
+    while (!calibration->done) {
+        // Attempts can't be split, so after the first don't start one expected to overrun.
+        if (attempted && calibration->attempts > 0) {
+            const uint32_t elapsed_us =
+                calibration_cycles_to_us(calibration_cycles_now() - slice_start);
+            const uint32_t expected_us =
+                calibration_cycles_to_us(calibration->cycles / calibration->attempts);
+            if (elapsed_us + expected_us > budget_us) {
+                break;
+            }
+        }
+
+        const MineSweeperConfig config = minesweeper_calibration_config(calibration->class_index);
+        const MineSweeperStrategyOps* ops = minesweeper_strategy_ops(calibration->strategy);
+        const uint16_t mine_count = minesweeper_engine_mine_count(&config);
+
+        const uint32_t attempt_start = calibration_cycles_now();
+        uint16_t cleared = 0;
+        board_init(&calibration->board, config.width, config.height);
+        if (!ops->place(&calibration->board, mine_count, &cleared) && !ops->self_verifying) {
+            check_board_with_solver(&calibration->board);
+        }
+        calibration->cycles += calibration_cycles_now() - attempt_start;
+        calibration->attempts++;
+        attempted = true;
+
+        const uint32_t spent_us = calibration_cycles_to_us(calibration->cycles);
+        if (calibration->attempts >= CALIBRATION_MIN_ATTEMPTS &&
+            spent_us >= CALIBRATION_BUDGET_US) {
+            calibration->cost_us[calibration->strategy] =
+                (float)spent_us / (float)calibration->attempts;
+            calibration->strategy++;
+            minesweeper_calibration_advance(calibration);
+        }
+
+        if (calibration_cycles_to_us(calibration_cycles_now() - slice_start) >= budget_us) {
+            break;
+        }
+    }
+
+    return !calibration->done;
+}
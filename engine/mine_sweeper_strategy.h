@@ -0,0 +1,93 @@
+#ifndef MINE_SWEEPER_STRATEGY_H
+#define MINE_SWEEPER_STRATEGY_H
+
+#include "mine_sweeper_engine.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+
+/** Generation strategies.
+  *
+  * Each strategy lays out candidate boards behind a small function table, so
+  * the generation job, new_game and the host tools drive all of them the same
+  * way. Strategies that check their own boards (constructive repair) conclude
+  * an attempt in one call; the others hand their candidate to the step-wise
+  * solver, which the job can spread over several time slices.
+  *
+  * Which strategy a config uses comes from the on-device calibration when one
+  * has been run for its class, and from the atlas otherwise.
+  */
+
+typedef enum {
+    // Random layouts until the solver clears one
+    MineSweeperStrategyRejection = 0,
+    // Random layout repaired wherever the solver gets stuck (board_generate_constructive)
+    MineSweeperStrategyConstructive,
+    MineSweeperStrategyCount,
+} MineSweeperStrategy;
+
+typedef struct {
+    const char* name;
+    // Checks its own boards, so an attempt can't be split across time slices
+    bool self_verifying;
+    /* Lays out a candidate with mine_count mines on a board fresh from
+     * board_init. Self-verifying strategies return whether it is solvable from
+     * the top left tile and report how many tiles their last solver pass
+     * cleared; the others return false and leave the check to the caller. */
+    bool (*place)(MineSweeperBoard* board, uint16_t mine_count, uint16_t* cleared_out);
+} MineSweeperStrategyOps;
+
+const MineSweeperStrategyOps* minesweeper_strategy_ops(MineSweeperStrategy strategy);
+
+/* Calibration classes: every difficulty split into board size bands by tile count. */
+#define MINESWEEPER_STRATEGY_SIZE_CLASSES (4u)
+#define MINESWEEPER_STRATEGY_CLASS_COUNT \
+    (MINESWEEPER_DIFFICULTY_COUNT * MINESWEEPER_STRATEGY_SIZE_CLASSES)
+
+uint8_t minesweeper_strategy_class(const MineSweeperConfig* config);
+
+/* Strategy for a config: rejection unless it asks for solvable boards, then
+ * the calibrated choice for its class, or the atlas's if it has none. */
+MineSweeperStrategy minesweeper_strategy_pick(const MineSweeperConfig* config);
+
+/* Calibrated choice per class, MineSweeperStrategyCount where there is none.
+ * May be set from any thread; jobs begun afterwards pick it up. */
+void minesweeper_strategy_set_tuning(const uint8_t* per_class);
+
+void minesweeper_strategy_get_tuning(uint8_t* per_class);
+
+/** On-device calibration.
+  *
+  * Times each strategy on one board size per class, on this device and
+  * firmware, and combines that with the atlas's acceptance rates (which only
+  * depend on the engine's code) into boards per second. Each class then gets
+  * the strategy minesweeper_atlas_pick_strategy prefers at those speeds.
+  * Strategies the atlas has never seen succeed for a class are skipped.
+  * Runs in small slices, a few hundred milliseconds per class in total.
+  */
+typedef struct {
+    uint8_t class_index;
+    uint8_t strategy;
+    uint32_t attempts;
+    uint32_t cycles; // spent on the current strategy and class so far
+    float cost_us[MineSweeperStrategyCount];
+    uint8_t result[MINESWEEPER_STRATEGY_CLASS_COUNT];
+    bool done;
+    MineSweeperBoard board;
+} MineSweeperCalibration;
+
+void minesweeper_calibration_begin(MineSweeperCalibration* calibration);
+
+/* Runs attempts for about budget_us: at least one, then only those expected to
+ * fit. Returns true while there is work left; afterwards result holds the
+ * choice for every class. */
+bool minesweeper_calibration_step(MineSweeperCalibration* calibration, uint32_t budget_us);
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+#endif // MINE_SWEEPER_STRATEGY_H
@@ -99,6 +99,10 @@ static inline void point_visited_set(uint8_t* visited, uint16_t tile_index) {
     visited[tile_index >> 3u] |= (uint8_t)(1u << (tile_index & 0x07u));
 }
 
+static inline void point_visited_clear_bit(uint8_t* visited, uint16_t tile_index) {
+    visited[tile_index >> 3u] &= (uint8_t)~(1u << (tile_index & 0x07u));
+}
+
 #ifdef __cplusplus
 }
 #endif // __cplusplus
@@ -0,0 +1,219 @@
+#include <flipper_format/flipper_format.h>
+#include <storage/storage.h>
+
+#include "helpers/mine_sweeper_board_pack.h"
+#include "helpers/mine_sweeper_config.h"
+#include "engine/mine_sweeper_board_pack_format.h"
+#include "engine/mine_sweeper_codec.h"
+#include "engine/mstarlib_helpers.h"
+
+static bool mine_sweeper_board_pack_read_exact(File* file, uint8_t* buffer, size_t size) {
+    return storage_file_read(file, buffer, size) == size;
+}
+
+static bool mine_sweeper_board_pack_find_group(
+    File* file,
+    const MineSweeperConfig* config,
+    const BoardPackHeader* header,
+    BoardPackGroup* group,
+    uint16_t* group_index) {
+    uint8_t raw[BOARD_PACK_GROUP_SIZE];
+
+    if (!storage_file_seek(file, BOARD_PACK_HEADER_SIZE, true)) return false;
+
+    for (uint16_t i = 0; i < header->group_count; ++i) {
+        if (!mine_sweeper_board_pack_read_exact(file, raw, sizeof(raw))) return false;
+
+        board_pack_parse_group(raw, group);
+        if (group->width == config->width && group->height == config->height &&
+            group->difficulty == config->difficulty) {
+            *group_index = i;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// A cursor is the index of the group's current board shifted up by 8, over a
+// mask of the transforms of that board already played.
+#define BOARD_PACK_CURSOR_SHIFT (8u)
+#define BOARD_PACK_CURSOR_MASK  (0xFFu)
+
+// Cursors live in a small FlipperFormat file next to the settings, one per pack group.
+// A different pack_id means the pack was replaced and every group starts over.
+static void mine_sweeper_board_pack_read_cursors(
+    Storage* storage,
+    const BoardPackHeader* header,
+    uint32_t* cursors) {
+    memset(cursors, 0, sizeof(uint32_t) * header->group_count);
+
+    FlipperFormat* fff_file = flipper_format_file_alloc(storage);
+    FuriString* temp_str = furi_string_alloc();
+    uint32_t file_version = 0;
+    uint32_t pack_id = 0;
+    uint32_t count = 0;
+
+    if (!flipper_format_file_open_existing(fff_file, MINESWEEPER_BOARD_PACK_STATE_PATH) ||
+        !flipper_format_read_header(fff_file, temp_str, &file_version) ||
+        (file_version != MINESWEEPER_BOARD_PACK_STATE_VERSION &&
+         file_version != MINESWEEPER_BOARD_PACK_STATE_VERSION_BOARDS) ||
+        !flipper_format_read_uint32(fff_file, MINESWEEPER_BOARD_PACK_KEY_PACK_ID, &pack_id, 1) ||
+        pack_id != header->pack_id || !flipper_format_rewind(fff_file) ||
+        !flipper_format_get_value_count(fff_file, MINESWEEPER_BOARD_PACK_KEY_CURSORS, &count) ||
+        count != header->group_count) {
+        goto cleanup;
+    }
+
+    if (!flipper_format_rewind(fff_file) ||
+        !flipper_format_read_uint32(
+            fff_file, MINESWEEPER_BOARD_PACK_KEY_CURSORS, cursors, header->group_count)) {
+        FURI_LOG_W(TAG, "Board pack cursors unreadable, starting over");
+        memset(cursors, 0, sizeof(uint32_t) * header->group_count);
+    } else if (file_version == MINESWEEPER_BOARD_PACK_STATE_VERSION_BOARDS) {
+        for (uint16_t i = 0; i < header->group_count; ++i) {
+            cursors[i] <<= BOARD_PACK_CURSOR_SHIFT;
+        }
+    }
+
+cleanup:
+    flipper_format_free(fff_file);
+    furi_string_free(temp_str);
+}
+
+static bool mine_sweeper_board_pack_write_cursors(
+    Storage* storage,
+    const BoardPackHeader* header,
+    const uint32_t* cursors) {
+    FlipperFormat* fff_file = flipper_format_file_alloc(storage);
+    uint32_t pack_id = header->pack_id;
+    bool ok = false;
+
+    if (flipper_format_file_open_always(fff_file, MINESWEEPER_BOARD_PACK_STATE_PATH) &&
+        flipper_format_write_header_cstr(
+            fff_file, MINESWEEPER_BOARD_PACK_STATE_HEADER, MINESWEEPER_BOARD_PACK_STATE_VERSION) &&
+        flipper_format_write_uint32(fff_file, MINESWEEPER_BOARD_PACK_KEY_PACK_ID, &pack_id, 1) &&
+        flipper_format_write_uint32(
+            fff_file, MINESWEEPER_BOARD_PACK_KEY_CURSORS, cursors, header->group_count)) {
+        ok = true;
+    }
+
+    flipper_format_free(fff_file);
+    return ok;
+}
+
+bool mine_sweeper_board_pack_take(const MineSweeperConfig* config, MineSweeperState* out_state) {
+    furi_assert(config);
+    furi_assert(out_state);
+
+    // Packs only hold verified boards; unverified games generate instantly anyway.
+    // Pack boards were not picked for any click count, so a 3BV range generates too.
+    if (!config->ensure_solvable || config->bbbv_min != 0 || config->bbbv_max != 0) {
+        return false;
+    }
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(storage);
+    uint32_t* cursors = NULL;
+    bool taken = false;
+
+    uint8_t raw_header[BOARD_PACK_HEADER_SIZE];
+    BoardPackHeader header;
+    BoardPackGroup group;
+    uint16_t group_index = 0;
+
+    if (!storage_file_open(file, MINESWEEPER_BOARD_PACK_PATH, FSAM_READ, FSOM_OPEN_EXISTING)) {
+        goto cleanup;
+    }
+
+    if (!mine_sweeper_board_pack_read_exact(file, raw_header, sizeof(raw_header)) ||
+        !board_pack_parse_header(raw_header, &header) ||
+        (header.version != BOARD_PACK_VERSION && header.version != BOARD_PACK_VERSION_RAW)) {
+        FURI_LOG_W(TAG, "Board pack header invalid: %s", MINESWEEPER_BOARD_PACK_PATH);
+        goto cleanup;
+    }
+
+    if (!mine_sweeper_board_pack_find_group(file, config, &header, &group, &group_index)) {
+        goto cleanup;
+    }
+
+    const uint16_t tile_count = (uint16_t)config->width * config->height;
+    const uint16_t mine_count = minesweeper_engine_mine_count(config);
+    const bool is_encoded = header.version != BOARD_PACK_VERSION_RAW;
+    const bool stride_ok = is_encoded ?
+                               group.board_stride <= BOARD_CODEC_MAX_BYTES &&
+                                   group.mine_count == mine_count :
+                               group.board_stride >= (tile_count + 7u) / 8u &&
+                                   group.board_stride <= BOARD_MINE_BITMAP_BYTES;
+    // Every slot has to lie inside the file, so no seek below can wrap around.
+    const uint64_t group_end =
+        (uint64_t)group.offset + (uint64_t)group.board_count * group.board_stride;
+    if (!stride_ok || group.board_count > (UINT32_MAX >> BOARD_PACK_CURSOR_SHIFT) ||
+        group_end > storage_file_size(file) || group_end > UINT32_MAX) {
+        FURI_LOG_W(TAG, "Board pack group %u is malformed", group_index);
+        goto cleanup;
+    }
+
+    cursors = malloc(sizeof(uint32_t) * header.group_count);
+    mine_sweeper_board_pack_read_cursors(storage, &header, cursors);
+
+    // Each board is played once per transform that starts from the configured corner.
+    uint32_t board_index = cursors[group_index] >> BOARD_PACK_CURSOR_SHIFT;
+    uint8_t used = (uint8_t)(cursors[group_index] & BOARD_PACK_CURSOR_MASK);
+    MineSweeperTransform transform =
+        board_pick_transform(config->width, config->height, config->start_corner, used);
+    if (transform == MineSweeperTransformCount) {
+        board_index++;
+        used = 0;
+        transform = board_pick_transform(config->width, config->height, config->start_corner, 0);
+    }
+    if (board_index >= group.board_count) {
+        goto cleanup;
+    }
+
+    uint8_t slot[BOARD_CODEC_MAX_BYTES] = {0};
+    if (!storage_file_seek(file, group.offset + board_index * group.board_stride, true) ||
+        !mine_sweeper_board_pack_read_exact(file, slot, group.board_stride)) {
+        FURI_LOG_W(TAG, "Board pack read failed at board %lu", (unsigned long)board_index);
+        goto cleanup;
+    }
+
+    uint8_t mines[BOARD_MINE_BITMAP_BYTES] = {0};
+    bool mines_ok = true;
+    if (is_encoded) {
+        board_codec_decode(slot, group.board_stride, tile_count, group.mine_count, mines);
+    } else {
+        // Raw slots carry no mine count, so one of another density is caught here.
+        memcpy(mines, slot, group.board_stride);
+        uint16_t found = 0;
+        for (uint16_t i = 0; i < tile_count; ++i) {
+            found += point_visited_test(mines, i) ? 1u : 0u;
+        }
+        mines_ok = found == mine_count;
+    }
+
+    // Advance first, so a variant that turns out to be bad is skipped next time too.
+    used |= (uint8_t)(1u << transform);
+    cursors[group_index] = (board_index << BOARD_PACK_CURSOR_SHIFT) | used;
+    if (!mine_sweeper_board_pack_write_cursors(storage, &header, cursors)) {
+        FURI_LOG_W(TAG, "Failed to save board pack cursor");
+    }
+
+    if (!mines_ok) {
+        FURI_LOG_W(
+            TAG, "Board pack board %lu has the wrong mine count", (unsigned long)board_index);
+        goto cleanup;
+    }
+
+    taken = minesweeper_engine_load_board(out_state, config, mines, transform) ==
+                MineSweeperResultChanged &&
+            minesweeper_engine_validate_state(out_state) != MineSweeperResultInvalid;
+
+cleanup:
+    if (cursors) free(cursors);
+    storage_file_close(file);
+    storage_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+
+    return taken;
+}
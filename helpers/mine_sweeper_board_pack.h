@@ -0,0 +1,24 @@
+#ifndef MINESWEEPER_BOARD_PACK_H
+#define MINESWEEPER_BOARD_PACK_H
+
+#include "engine/mine_sweeper_engine.h"
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+
+/** Start a game on the next unused board for this config from the SD card
+  * board pack. Only the pack header, one index entry and one board are read.
+  * Each board is played once per transform that starts from the configured
+  * corner. The cursor is saved before returning, so a variant is never
+  * handed out twice. Returns false if there is no pack, no group for this
+  * config, the group has run out, or the config asks for a 3BV range.
+  */
+bool mine_sweeper_board_pack_take(const MineSweeperConfig* config, MineSweeperState* out_state);
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+#endif // MINESWEEPER_BOARD_PACK_H
@@ -9,19 +9,43 @@ extern "C" {
 #define TAG "Mine Sweeper Application"
 
 // Storage Helper Defines
-#define MINESWEEPER_SETTINGS_FILE_VERSION               3
+#define MINESWEEPER_SETTINGS_FILE_VERSION               6
 #define MINESWEEPER_SETTINGS_FILE_VERSION_MIN_SUPPORTED 2
+#define MINESWEEPER_SETTINGS_FILE_VERSION_SOLVABLE      3
+#define MINESWEEPER_SETTINGS_FILE_VERSION_DEFERRED      4
+#define MINESWEEPER_SETTINGS_FILE_VERSION_START_CORNER  5
+#define MINESWEEPER_SETTINGS_FILE_VERSION_CLICKS        6
 #define CONFIG_FILE_DIRECTORY_PATH                      EXT_PATH("apps_data/mine_sweeper_redux")
 #define MINESWEEPER_SETTINGS_SAVE_PATH                  CONFIG_FILE_DIRECTORY_PATH "/mine_sweeper_redux.conf"
 #define MINESWEEPER_SETTINGS_SAVE_PATH_TMP              MINESWEEPER_SETTINGS_SAVE_PATH ".tmp"
 #define MINESWEEPER_SETTINGS_HEADER                     "Mine Sweeper Redux Config File"
 
+// Board pack on the SD card and the record of which boards were already used
+#define MINESWEEPER_BOARD_PACK_PATH          CONFIG_FILE_DIRECTORY_PATH "/boards.pack"
+#define MINESWEEPER_BOARD_PACK_STATE_PATH    CONFIG_FILE_DIRECTORY_PATH "/boards_pack.state"
+#define MINESWEEPER_BOARD_PACK_STATE_HEADER  "Mine Sweeper Redux Board Pack State"
+#define MINESWEEPER_BOARD_PACK_STATE_VERSION 2
+// Version 1 cursors counted whole boards, version 2 adds a used-transform byte
+#define MINESWEEPER_BOARD_PACK_STATE_VERSION_BOARDS 1
+#define MINESWEEPER_BOARD_PACK_KEY_PACK_ID   "PackId"
+#define MINESWEEPER_BOARD_PACK_KEY_CURSORS   "Cursors"
+
+// Strategy calibration, redone whenever the firmware build changes
+#define MINESWEEPER_TUNING_PATH           CONFIG_FILE_DIRECTORY_PATH "/strategy.tuning"
+#define MINESWEEPER_TUNING_HEADER         "Mine Sweeper Redux Strategy Tuning"
+#define MINESWEEPER_TUNING_VERSION        1
+#define MINESWEEPER_TUNING_KEY_FIRMWARE   "Firmware"
+#define MINESWEEPER_TUNING_KEY_STRATEGIES "Strategies"
+
 #define MINESWEEPER_SETTINGS_KEY_WIDTH      "BoardWidth"
 #define MINESWEEPER_SETTINGS_KEY_HEIGHT     "BoardHeight"
 #define MINESWEEPER_SETTINGS_KEY_DIFFICULTY "BoardDifficulty"
 #define MINESWEEPER_SETTINGS_KEY_FEEDBACK   "FeedbackEnabled"
 #define MINESWEEPER_SETTINGS_KEY_WRAP       "WrapEnabled"
 #define MINESWEEPER_SETTINGS_KEY_SOLVABLE   "EnsureSolvable"
+#define MINESWEEPER_SETTINGS_KEY_DEFERRED   "DeferredGeneration"
+#define MINESWEEPER_SETTINGS_KEY_CORNER     "StartCorner"
+#define MINESWEEPER_SETTINGS_KEY_CLICKS     "ClicksBand"
 
 #ifdef __cplusplus
 }
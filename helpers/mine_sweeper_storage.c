@@ -1,6 +1,9 @@
 #include <flipper_format/flipper_format.h>
+#include <furi_hal_version.h>
+#include <toolbox/version.h>
 
 #include "minesweeper.h"
+#include "engine/mine_sweeper_strategy.h"
 #include "helpers/mine_sweeper_config.h"
 #include "helpers/mine_sweeper_storage.h"
 
@@ -60,6 +63,9 @@ static bool mine_sweeper_write_settings_payload(FlipperFormat* file, const MineS
     uint32_t f = app->feedback_enabled;
     uint32_t wr = app->wrap_enabled;
     uint32_t s = app->settings_committed.ensure_solvable_board ? 1U : 0U;
+    uint32_t dg = app->deferred_generation_enabled;
+    uint32_t sc = app->start_corner;
+    uint32_t cb = app->settings_committed.clicks_band;
 
     if (!flipper_format_write_header_cstr(
             file, MINESWEEPER_SETTINGS_HEADER, MINESWEEPER_SETTINGS_FILE_VERSION)) {
@@ -72,6 +78,9 @@ static bool mine_sweeper_write_settings_payload(FlipperFormat* file, const MineS
     if (!flipper_format_write_uint32(file, MINESWEEPER_SETTINGS_KEY_FEEDBACK, &f, 1)) return false;
     if (!flipper_format_write_uint32(file, MINESWEEPER_SETTINGS_KEY_WRAP, &wr, 1)) return false;
     if (!flipper_format_write_uint32(file, MINESWEEPER_SETTINGS_KEY_SOLVABLE, &s, 1)) return false;
+    if (!flipper_format_write_uint32(file, MINESWEEPER_SETTINGS_KEY_DEFERRED, &dg, 1)) return false;
+    if (!flipper_format_write_uint32(file, MINESWEEPER_SETTINGS_KEY_CORNER, &sc, 1)) return false;
+    if (!flipper_format_write_uint32(file, MINESWEEPER_SETTINGS_KEY_CLICKS, &cb, 1)) return false;
 
     return true;
 }
@@ -233,6 +242,9 @@ bool mine_sweeper_read_settings(void* context) {
     uint32_t f = 1;
     uint32_t wr = 1;
     uint32_t s = 0;
+    uint32_t dg = 0;
+    uint32_t sc = MineSweeperStartCornerTopLeft;
+    uint32_t cb = MineSweeperClicksAny;
 
     if (!mine_sweeper_read_uint32_or_default(fff_file, MINESWEEPER_SETTINGS_KEY_WIDTH, &w, 16)) {
         FURI_LOG_W(TAG, "Missing/corrupt key: %s", MINESWEEPER_SETTINGS_KEY_WIDTH);
@@ -256,7 +268,7 @@ bool mine_sweeper_read_settings(void* context) {
         migrate_after_read = true;
     }
 
-    if (file_version >= MINESWEEPER_SETTINGS_FILE_VERSION) {
+    if (file_version >= MINESWEEPER_SETTINGS_FILE_VERSION_SOLVABLE) {
         if (!mine_sweeper_read_uint32_or_default(
                 fff_file, MINESWEEPER_SETTINGS_KEY_SOLVABLE, &s, 0)) {
             FURI_LOG_W(TAG, "Missing/corrupt key: %s", MINESWEEPER_SETTINGS_KEY_SOLVABLE);
@@ -267,19 +279,58 @@ bool mine_sweeper_read_settings(void* context) {
         migrate_after_read = true;
     }
 
+    if (file_version >= MINESWEEPER_SETTINGS_FILE_VERSION_DEFERRED) {
+        if (!mine_sweeper_read_uint32_or_default(
+                fff_file, MINESWEEPER_SETTINGS_KEY_DEFERRED, &dg, 0)) {
+            FURI_LOG_W(TAG, "Missing/corrupt key: %s", MINESWEEPER_SETTINGS_KEY_DEFERRED);
+            migrate_after_read = true;
+        }
+    } else {
+        dg = 0;
+        migrate_after_read = true;
+    }
+
+    if (file_version >= MINESWEEPER_SETTINGS_FILE_VERSION_START_CORNER) {
+        if (!mine_sweeper_read_uint32_or_default(
+                fff_file, MINESWEEPER_SETTINGS_KEY_CORNER, &sc, MineSweeperStartCornerTopLeft)) {
+            FURI_LOG_W(TAG, "Missing/corrupt key: %s", MINESWEEPER_SETTINGS_KEY_CORNER);
+            migrate_after_read = true;
+        }
+    } else {
+        sc = MineSweeperStartCornerTopLeft;
+        migrate_after_read = true;
+    }
+
+    if (file_version >= MINESWEEPER_SETTINGS_FILE_VERSION_CLICKS) {
+        if (!mine_sweeper_read_uint32_or_default(
+                fff_file, MINESWEEPER_SETTINGS_KEY_CLICKS, &cb, MineSweeperClicksAny)) {
+            FURI_LOG_W(TAG, "Missing/corrupt key: %s", MINESWEEPER_SETTINGS_KEY_CLICKS);
+            migrate_after_read = true;
+        }
+    } else {
+        cb = MineSweeperClicksAny;
+        migrate_after_read = true;
+    }
+
     w = clamp(16, 32, w);
     h = clamp(7, 32, h);
-    d = clamp(0, 2, d);
+    d = clamp(0, MINESWEEPER_DIFFICULTY_COUNT - 1, d);
     f = clamp(0, 1, f);
     wr = clamp(0, 1, wr);
     s = clamp(0, 1, s);
+    dg = clamp(0, 1, dg);
+    sc = clamp(0, MineSweeperStartCornerCount - 1, sc);
+    cb = clamp(0, MineSweeperClicksCount - 1, cb);
 
     app->settings_committed.board_width = (uint8_t)w;
     app->settings_committed.board_height = (uint8_t)h;
     app->settings_committed.difficulty = (uint8_t)d;
     app->settings_committed.ensure_solvable_board = (s != 0);
+    app->settings_committed.clicks_band = (uint8_t)cb;
     app->feedback_enabled = (uint8_t)f;
     app->wrap_enabled = (uint8_t)wr;
+    app->deferred_generation_enabled = (uint8_t)dg;
+    app->start_corner = (uint8_t)sc;
 
     read_ok = true;
 
@@ -302,3 +353,88 @@ cleanup:
 
     return read_ok;
 }
+
+// Timings only hold for the build they were taken on, so the tuning is keyed by its git hash.
+static const char* mine_sweeper_firmware_id(void) {
+    const char* githash = version_get_githash(furi_hal_version_get_firmware_version());
+    return githash ? githash : "";
+}
+
+bool mine_sweeper_read_strategy_tuning(void) {
+    Storage* storage = mine_sweeper_open_storage();
+    if (storage == NULL) {
+        FURI_LOG_E(TAG, "Failed to open storage record");
+        return false;
+    }
+
+    FlipperFormat* fff_file = flipper_format_file_alloc(storage);
+    FuriString* temp_str = furi_string_alloc();
+    uint32_t file_version = 0;
+    uint32_t count = 0;
+    uint32_t strategies[MINESWEEPER_STRATEGY_CLASS_COUNT];
+    bool read_ok = false;
+
+    if (!flipper_format_file_open_existing(fff_file, MINESWEEPER_TUNING_PATH) ||
+        !flipper_format_read_header(fff_file, temp_str, &file_version) ||
+        file_version != MINESWEEPER_TUNING_VERSION ||
+        !flipper_format_read_string(fff_file, MINESWEEPER_TUNING_KEY_FIRMWARE, temp_str) ||
+        !furi_string_equal_str(temp_str, mine_sweeper_firmware_id()) ||
+        !flipper_format_get_value_count(fff_file, MINESWEEPER_TUNING_KEY_STRATEGIES, &count) ||
+        count != MINESWEEPER_STRATEGY_CLASS_COUNT ||
+        !flipper_format_read_uint32(
+            fff_file,
+            MINESWEEPER_TUNING_KEY_STRATEGIES,
+            strategies,
+            MINESWEEPER_STRATEGY_CLASS_COUNT)) {
+        goto cleanup;
+    }
+
+    uint8_t per_class[MINESWEEPER_STRATEGY_CLASS_COUNT];
+    for (uint8_t i = 0; i < MINESWEEPER_STRATEGY_CLASS_COUNT; ++i) {
+        per_class[i] = (uint8_t)clamp(0, MineSweeperStrategyCount, strategies[i]);
+    }
+    minesweeper_strategy_set_tuning(per_class);
+    read_ok = true;
+
+cleanup:
+    mine_sweeper_free_config_file(fff_file);
+    furi_string_free(temp_str);
+    mine_sweeper_close_storage();
+
+    return read_ok;
+}
+
+void mine_sweeper_save_strategy_tuning(void) {
+    uint8_t per_class[MINESWEEPER_STRATEGY_CLASS_COUNT];
+    uint32_t strategies[MINESWEEPER_STRATEGY_CLASS_COUNT];
+
+    minesweeper_strategy_get_tuning(per_class);
+    for (uint8_t i = 0; i < MINESWEEPER_STRATEGY_CLASS_COUNT; ++i) {
+        strategies[i] = per_class[i];
+    }
+
+    Storage* storage = mine_sweeper_open_storage();
+    if (storage == NULL) {
+        FURI_LOG_E(TAG, "Failed to open storage record");
+        return;
+    }
+
+    FlipperFormat* fff_file = flipper_format_file_alloc(storage);
+
+    if (!mine_sweeper_ensure_config_directory(storage) ||
+        !flipper_format_file_open_always(fff_file, MINESWEEPER_TUNING_PATH) ||
+        !flipper_format_write_header_cstr(
+            fff_file, MINESWEEPER_TUNING_HEADER, MINESWEEPER_TUNING_VERSION) ||
+        !flipper_format_write_string_cstr(
+            fff_file, MINESWEEPER_TUNING_KEY_FIRMWARE, mine_sweeper_firmware_id()) ||
+        !flipper_format_write_uint32(
+            fff_file,
+            MINESWEEPER_TUNING_KEY_STRATEGIES,
+            strategies,
+            MINESWEEPER_STRATEGY_CLASS_COUNT)) {
+        FURI_LOG_E(TAG, "Failed to save strategy tuning: %s", MINESWEEPER_TUNING_PATH);
+    }
+
+    mine_sweeper_free_config_file(fff_file);
+    mine_sweeper_close_storage();
+}
@@ -10,6 +10,12 @@ extern "C" {
 void mine_sweeper_save_settings(void* context);
 bool mine_sweeper_read_settings(void* context);
 
+/* Hands the strategy calibration saved for the running firmware to the engine.
+ * Returns false if there is none, in which case a calibration should be run. */
+bool mine_sweeper_read_strategy_tuning(void);
+/* Saves the engine's current strategy calibration for the running firmware. */
+void mine_sweeper_save_strategy_tuning(void);
+
 #ifdef __cplusplus
 }
 #endif // __cplusplus
@@ -0,0 +1,247 @@
+#include "helpers/mine_sweeper_worker.h"
+#include "engine/mine_sweeper_board_pool.h"
+#include "engine/mine_sweeper_strategy.h"
+
+#include <furi.h>
+
+#define MINESWEEPER_WORKER_STACK_SIZE (2 * 1024)
+
+// Work done per slice. Small boards batch many attempts into one slice, large
+// ones run a single attempt.
+#define MINESWEEPER_WORKER_SLICE_US (10u * 1000u)
+
+typedef enum {
+    MineSweeperWorkerFlagExit = (1 << 0),
+    MineSweeperWorkerFlagJob = (1 << 1),
+} MineSweeperWorkerFlag;
+
+#define MINESWEEPER_WORKER_FLAGS_ALL (MineSweeperWorkerFlagExit | MineSweeperWorkerFlagJob)
+
+struct MineSweeperWorker {
+    FuriThread* thread;
+
+    // Guards the fields below. Only held to hand work over, never while an
+    // attempt runs, so GUI calls don't wait on generation.
+    FuriMutex* mutex;
+    MineSweeperGenerationJob* job;
+    bool job_busy; // the thread is stepping job with the mutex released
+
+    // Refilled whenever no foreground job needs the thread. The refill job is
+    // stepped by the thread alone; the rest of the pool is behind the mutex.
+    MineSweeperBoardPool pool;
+
+    // Strategy calibration, run once the pool is full and stepped by the thread
+    // alone. A newly queued one waits in calibration_queued until the thread
+    // is between steps.
+    MineSweeperCalibration* calibration;
+    MineSweeperCalibration* calibration_queued;
+    bool calibration_finished;
+};
+
+// Applies a finished calibration's choices; the engine picks them up for new jobs.
+static void mine_sweeper_worker_finish_calibration(MineSweeperWorker* worker) {
+    minesweeper_strategy_set_tuning(worker->calibration->result);
+    free(worker->calibration);
+    worker->calibration = NULL;
+    worker->calibration_finished = worker->calibration_queued == NULL;
+}
+
+// One time slice of work. The attached job always goes first; the pool only gets
+// the thread once the player is no longer waiting on anything, and a queued
+// calibration once the pool is full. The work is picked and its result handed
+// back under the mutex, and done without it.
+static bool mine_sweeper_worker_step(MineSweeperWorker* worker) {
+    furi_check(furi_mutex_acquire(worker->mutex, FuriWaitForever) == FuriStatusOk);
+
+    if (worker->calibration_queued) {
+        free(worker->calibration);
+        worker->calibration = worker->calibration_queued;
+        worker->calibration_queued = NULL;
+    }
+
+    MineSweeperGenerationJob* job = worker->job;
+    if (job &&
+        minesweeper_engine_generation_status(job) != MineSweeperGenerationStatusInProgress) {
+        job = NULL;
+    }
+    worker->job_busy = job != NULL;
+
+    MineSweeperGenerationJob* refill = job ? NULL : board_pool_refill_job(&worker->pool);
+    MineSweeperCalibration* calibration = job || refill ? NULL : worker->calibration;
+
+    furi_mutex_release(worker->mutex);
+
+    bool has_more_work = true;
+    if (job || refill) {
+        minesweeper_engine_generation_step_timed(job ? job : refill, MINESWEEPER_WORKER_SLICE_US);
+    } else if (calibration) {
+        has_more_work = minesweeper_calibration_step(calibration, MINESWEEPER_WORKER_SLICE_US);
+    } else {
+        return false;
+    }
+
+    furi_check(furi_mutex_acquire(worker->mutex, FuriWaitForever) == FuriStatusOk);
+
+    worker->job_busy = false;
+    if (refill) {
+        has_more_work = board_pool_refill_collect(&worker->pool) || worker->calibration != NULL;
+    } else if (calibration && !has_more_work) {
+        mine_sweeper_worker_finish_calibration(worker);
+    }
+
+    furi_mutex_release(worker->mutex);
+
+    return has_more_work;
+}
+
+static int32_t mine_sweeper_worker_thread(void* context) {
+    furi_assert(context);
+    MineSweeperWorker* worker = context;
+
+    while (true) {
+        uint32_t flags = furi_thread_flags_wait(
+            MINESWEEPER_WORKER_FLAGS_ALL, FuriFlagWaitAny, FuriWaitForever);
+
+        if (flags & FuriFlagError) continue;
+        if (flags & MineSweeperWorkerFlagExit) break;
+
+        while (mine_sweeper_worker_step(worker)) {
+            if (furi_thread_flags_get() & MineSweeperWorkerFlagExit) break;
+        }
+
+        if (furi_thread_flags_get() & MineSweeperWorkerFlagExit) break;
+    }
+
+    return 0;
+}
+
+MineSweeperWorker* mine_sweeper_worker_alloc(void) {
+    MineSweeperWorker* worker = malloc(sizeof(MineSweeperWorker));
+    if (!worker) {
+        return NULL;
+    }
+
+    worker->job = NULL;
+    worker->job_busy = false;
+    board_pool_init(&worker->pool);
+    worker->calibration = NULL;
+    worker->calibration_queued = NULL;
+    worker->calibration_finished = false;
+    worker->mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+
+    worker->thread = furi_thread_alloc_ex(
+        "MineSweeperGen", MINESWEEPER_WORKER_STACK_SIZE, mine_sweeper_worker_thread, worker);
+    furi_thread_set_priority(worker->thread, FuriThreadPriorityLow);
+    furi_thread_start(worker->thread);
+
+    return worker;
+}
+
+void mine_sweeper_worker_free(MineSweeperWorker* worker) {
+    furi_assert(worker);
+
+    furi_thread_flags_set(furi_thread_get_id(worker->thread), MineSweeperWorkerFlagExit);
+    furi_thread_join(worker->thread);
+    furi_thread_free(worker->thread);
+
+    furi_mutex_free(worker->mutex);
+    free(worker->calibration);
+    free(worker->calibration_queued);
+    free(worker);
+}
+
+void mine_sweeper_worker_attach_job(MineSweeperWorker* worker, MineSweeperGenerationJob* job) {
+    furi_assert(worker);
+    furi_assert(job);
+
+    furi_check(furi_mutex_acquire(worker->mutex, FuriWaitForever) == FuriStatusOk);
+    worker->job = job;
+    furi_mutex_release(worker->mutex);
+
+    furi_thread_flags_set(furi_thread_get_id(worker->thread), MineSweeperWorkerFlagJob);
+}
+
+bool mine_sweeper_worker_release_job(MineSweeperWorker* worker) {
+    furi_assert(worker);
+
+    furi_check(furi_mutex_acquire(worker->mutex, FuriWaitForever) == FuriStatusOk);
+    worker->job = NULL;
+    const bool released = !worker->job_busy;
+    furi_mutex_release(worker->mutex);
+
+    return released;
+}
+
+void mine_sweeper_worker_detach_job(MineSweeperWorker* worker) {
+    furi_assert(worker);
+
+    while (!mine_sweeper_worker_release_job(worker)) {
+        furi_delay_tick(1);
+    }
+}
+
+void mine_sweeper_worker_start_calibration(MineSweeperWorker* worker) {
+    furi_assert(worker);
+
+    // Too big for the GUI thread's stack, and only needed until it finishes.
+    MineSweeperCalibration* calibration = malloc(sizeof(MineSweeperCalibration));
+    furi_check(calibration);
+    minesweeper_calibration_begin(calibration);
+
+    furi_check(furi_mutex_acquire(worker->mutex, FuriWaitForever) == FuriStatusOk);
+    free(worker->calibration_queued);
+    worker->calibration_queued = calibration;
+    worker->calibration_finished = false;
+    furi_mutex_release(worker->mutex);
+
+    furi_thread_flags_set(furi_thread_get_id(worker->thread), MineSweeperWorkerFlagJob);
+}
+
+bool mine_sweeper_worker_calibration_finished(MineSweeperWorker* worker) {
+    furi_assert(worker);
+
+    furi_check(furi_mutex_acquire(worker->mutex, FuriWaitForever) == FuriStatusOk);
+    const bool finished = worker->calibration_finished;
+    furi_mutex_release(worker->mutex);
+
+    return finished;
+}
+
+void mine_sweeper_worker_set_pool_config(
+    MineSweeperWorker* worker,
+    const MineSweeperConfig* config) {
+    furi_assert(worker);
+    furi_assert(config);
+
+    furi_check(furi_mutex_acquire(worker->mutex, FuriWaitForever) == FuriStatusOk);
+    board_pool_set_config(&worker->pool, config);
+    furi_mutex_release(worker->mutex);
+
+    furi_thread_flags_set(furi_thread_get_id(worker->thread), MineSweeperWorkerFlagJob);
+}
+
+bool mine_sweeper_worker_take_board(
+    MineSweeperWorker* worker,
+    const MineSweeperConfig* config,
+    MineSweeperState* out_state) {
+    furi_assert(worker);
+    furi_assert(config);
+    furi_assert(out_state);
+
+    uint8_t mines[BOARD_MINE_BITMAP_BYTES];
+    MineSweeperTransform transform = MineSweeperTransformIdentity;
+
+    furi_check(furi_mutex_acquire(worker->mutex, FuriWaitForever) == FuriStatusOk);
+    const bool taken = board_pool_take(&worker->pool, config, mines, &transform);
+    furi_mutex_release(worker->mutex);
+
+    if (!taken) {
+        return false;
+    }
+
+    // Wake the thread in case that used up a board and freed a slot.
+    furi_thread_flags_set(furi_thread_get_id(worker->thread), MineSweeperWorkerFlagJob);
+
+    return minesweeper_engine_load_board(out_state, config, mines, transform) ==
+           MineSweeperResultChanged;
+}
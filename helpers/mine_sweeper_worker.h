@@ -0,0 +1,62 @@
+#ifndef MINESWEEPER_WORKER_H
+#define MINESWEEPER_WORKER_H
+
+#include "engine/mine_sweeper_engine.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+
+/** Background board generation.
+  *
+  * A low priority thread steps a MineSweeperGenerationJob between GUI events.
+  * While a job is attached the GUI may only read its status and attempt counter
+  * or cancel it; detach it before touching anything else. The thread only takes
+  * the worker's mutex to hand work over, never for a whole attempt, so calls
+  * from the GUI return straight away.
+  *
+  * With no job attached the thread keeps a small pool of boards for the
+  * current config topped up, so most new games can start without waiting.
+  * Once the pool is full it runs a queued strategy calibration, if any.
+  */
+typedef struct MineSweeperWorker MineSweeperWorker;
+
+MineSweeperWorker* mine_sweeper_worker_alloc(void);
+
+void mine_sweeper_worker_free(MineSweeperWorker* worker);
+
+/** Hand a job (already begun) to the worker thread. */
+void mine_sweeper_worker_attach_job(MineSweeperWorker* worker, MineSweeperGenerationJob* job);
+
+/** Stop stepping the job. True once the thread is out of it and the job is
+  * back; false while it is still finishing an attempt, so call again later.
+  * Never waits. */
+bool mine_sweeper_worker_release_job(MineSweeperWorker* worker);
+
+/** Take the job back, waiting out an attempt the thread is in the middle of.
+  * Only needed before reusing the job; a finished job is back right away. */
+void mine_sweeper_worker_detach_job(MineSweeperWorker* worker);
+
+/** Queue a strategy calibration (see mine_sweeper_strategy.h). Its result is
+  * handed to the engine as soon as it finishes. */
+void mine_sweeper_worker_start_calibration(MineSweeperWorker* worker);
+
+/** True once a queued calibration has finished and its result is in use. */
+bool mine_sweeper_worker_calibration_finished(MineSweeperWorker* worker);
+
+/** Retarget the board pool. Pooled boards for a different config are dropped. */
+void mine_sweeper_worker_set_pool_config(
+    MineSweeperWorker* worker,
+    const MineSweeperConfig* config);
+
+/** Start a game on a pooled board. Returns false if none is ready for this config. */
+bool mine_sweeper_worker_take_board(
+    MineSweeperWorker* worker,
+    const MineSweeperConfig* config,
+    MineSweeperState* out_state);
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+#endif // MINESWEEPER_WORKER_H
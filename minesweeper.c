@@ -24,6 +24,30 @@ static void minesweeper_tick_event_callback(void* context) {
     return scene_manager_handle_tick_event(app->scene_manager);
 }
 
+void minesweeper_adopt_deferred_mines(MineSweeperApp* app, const uint8_t* mines) {
+    furi_assert(app);
+    furi_assert(mines);
+
+    app->generation_deferred = false;
+    // Only the game scene has a hint; the generating scene's board gets a fresh one.
+    if (app->hint) hint_new_board(app->hint);
+
+    if (minesweeper_engine_adopt_mines(&app->game_state, mines) == MineSweeperResultChanged) {
+        return;
+    }
+
+    FURI_LOG_W(TAG, "Placeholder board already played, starting fresh");
+    const MineSweeperConfig* config = &app->generation_job.config;
+    minesweeper_engine_load_board(
+        &app->game_state,
+        config,
+        mines,
+        board_pick_transform(config->width, config->height, config->start_corner, 0));
+    mine_sweeper_game_screen_reset_clock(app->game_screen);
+    if (app->hint) hint_reset(app->hint);
+    app->deferred_reveal_pending = false;
+}
+
 static void app_free(MineSweeperApp* app);
 
 static MineSweeperApp* app_alloc(void) {
@@ -89,14 +113,29 @@ static MineSweeperApp* app_alloc(void) {
         app->settings_committed.board_height = 7;
         app->settings_committed.difficulty = 0;
         app->settings_committed.ensure_solvable_board = false;
+        app->settings_committed.clicks_band = MineSweeperClicksAny;
         app->feedback_enabled = 1;
         app->wrap_enabled = 1;
+        app->deferred_generation_enabled = 0;
+        app->start_corner = MineSweeperStartCornerTopLeft;
 
         mine_sweeper_save_settings(app);
     } else {
         FURI_LOG_I(TAG, "Save file loaded sucessfully");
     }
 
+    app->generation_worker = mine_sweeper_worker_alloc();
+    if (!app->generation_worker) {
+        FURI_LOG_E(TAG, "Failed to allocate generation worker");
+        goto cleanup;
+    }
+
+    // Time the generation strategies once per firmware build, in the background
+    if (!mine_sweeper_read_strategy_tuning()) {
+        FURI_LOG_I(TAG, "No strategy tuning for this firmware, calibrating");
+        mine_sweeper_worker_start_calibration(app->generation_worker);
+    }
+
     // Alloc views and add to view dispatcher
     app->start_screen = start_screen_alloc();
     if (!app->start_screen) {
@@ -126,13 +165,8 @@ static MineSweeperApp* app_alloc(void) {
         MineSweeperGeneratingScreenView,
         minesweeper_generating_view_get_view(app->generating_view));
 
-    MineSweeperConfig initial_config = {
-        .width = app->settings_committed.board_width,
-        .height = app->settings_committed.board_height,
-        .difficulty = app->settings_committed.difficulty,
-        .ensure_solvable = app->settings_committed.ensure_solvable_board,
-        .wrap_enabled = app->wrap_enabled,
-    };
+    MineSweeperConfig initial_config =
+        minesweeper_settings_to_config(app, &app->settings_committed);
 
     if (minesweeper_engine_set_config(&app->game_state, &initial_config) ==
         MineSweeperResultInvalid) {
@@ -140,6 +174,9 @@ static MineSweeperApp* app_alloc(void) {
         goto cleanup;
     }
 
+    // Start pregenerating while the player is still on the start screen
+    mine_sweeper_worker_set_pool_config(app->generation_worker, &initial_config);
+
     app->game_screen = mine_sweeper_game_screen_alloc();
     if (!app->game_screen) {
         FURI_LOG_E(TAG, "Failed to allocate game screen");
@@ -238,6 +275,14 @@ static void app_free(MineSweeperApp* app) {
         }
     }
 
+    // Stop background generation before anything it may be stepping goes away
+    if (app->generation_worker) {
+        if (mine_sweeper_worker_calibration_finished(app->generation_worker)) {
+            mine_sweeper_save_strategy_tuning();
+        }
+        mine_sweeper_worker_free(app->generation_worker);
+    }
+
     // Free views
     if (app->loading) {
         loading_free(app->loading);
@@ -251,6 +296,9 @@ static void app_free(MineSweeperApp* app) {
     if (app->game_screen) {
         mine_sweeper_game_screen_free(app->game_screen);
     }
+    if (app->hint) {
+        free(app->hint);
+    }
     if (app->menu_screen) {
         dialog_ex_free(app->menu_screen);
     }
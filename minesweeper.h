@@ -16,6 +16,8 @@
 #include "views/start_screen.h"
 #include "views/minesweeper_game_screen.h"
 #include "views/minesweeper_generating_view.h"
+#include "helpers/mine_sweeper_worker.h"
+#include "engine/mine_sweeper_hint.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -25,12 +27,14 @@ extern "C" {
 typedef struct {
     uint8_t board_width, board_height, difficulty;
     bool ensure_solvable_board;
+    uint8_t clicks_band; // MineSweeperClicksBand
     FuriString* width_str;
     FuriString* height_str;
     VariableItem* difficulty_item;
     VariableItem* width_item;
     VariableItem* height_item;
     VariableItem* solvable_item;
+    VariableItem* clicks_item;
 } MineSweeperAppSettings;
 
 typedef enum {
@@ -60,15 +64,49 @@ typedef struct MineSweeperApp {
 
     MineSweeperState game_state;
     MineSweeperGenerationJob generation_job;
+    MineSweeperWorker* generation_worker;
 
     uint8_t is_settings_changed;
     MineSweeperGenerationOrigin generation_origin;
     bool generation_user_preempted;
+    // Game screen is showing a placeholder while generation_job runs on the worker
+    bool generation_deferred;
+    // A reveal on the placeholder is waiting for the real board
+    bool deferred_reveal_pending;
+    // Hint for the board as it is now, stepped on ticks until it is ready. Only
+    // allocated while the game scene is up, NULL otherwise.
+    MineSweeperHintState* hint;
+    // Move the cursor to the hint's tile once it is ready
+    bool hint_jump_pending;
 
     uint8_t feedback_enabled;
     uint8_t wrap_enabled;
+    uint8_t deferred_generation_enabled;
+    uint8_t start_corner; // MineSweeperStartCorner
 } MineSweeperApp;
 
+// Engine config for a settings buffer plus the app-wide wrap and start corner options
+static inline MineSweeperConfig minesweeper_settings_to_config(
+    const MineSweeperApp* app,
+    const MineSweeperAppSettings* settings) {
+    MineSweeperConfig config = {
+        .width = settings->board_width,
+        .height = settings->board_height,
+        .difficulty = settings->difficulty,
+        .ensure_solvable = settings->ensure_solvable_board,
+        .wrap_enabled = app->wrap_enabled,
+        .start_corner = app->start_corner,
+    };
+    minesweeper_engine_set_clicks_band(&config, settings->clicks_band);
+
+    return config;
+}
+
+/* Puts a finished deferred board under the placeholder the player is on. If
+ * the placeholder was already played past what the board allows, the board
+ * starts fresh instead, with the clock, the hint and any pending reveal reset. */
+void minesweeper_adopt_deferred_mines(MineSweeperApp* app, const uint8_t* mines);
+
 // View Id Enumeration
 typedef enum {
     MineSweeperStartScreenView,
@@ -67,6 +67,7 @@ bool minesweeper_scene_confirmation_screen_on_event(void* context, SceneManagerE
             app->settings_committed.difficulty = app->settings_draft.difficulty;
             app->settings_committed.ensure_solvable_board =
                 app->settings_draft.ensure_solvable_board;
+            app->settings_committed.clicks_band = app->settings_draft.clicks_band;
 
             mine_sweeper_save_settings(app);
 
@@ -85,6 +86,13 @@ bool minesweeper_scene_confirmation_screen_on_event(void* context, SceneManagerE
 
             app->is_settings_changed = false;
 
+            // Drop anything pregenerated for the discarded draft
+            {
+                MineSweeperConfig config =
+                    minesweeper_settings_to_config(app, &app->settings_committed);
+                mine_sweeper_worker_set_pool_config(app->generation_worker, &config);
+            }
+
             // we want to just switch back to the game screen without resetting
             scene_manager_search_and_switch_to_another_scene(
                 app->scene_manager, MineSweeperSceneGameScreen);
@@ -7,6 +7,15 @@
 #include "engine/mine_sweeper_engine.h"
 #include "views/minesweeper_game_screen.h"
 #include <input/input.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Hint work done per tick: a few milliseconds on the Flipper, so the screen
+// stays responsive while a big frontier is worked through.
+#define HINT_WORK_PER_TICK (16384u)
+// Solver units run per tick towards the next sure tile, so one is usually
+// known before the player asks.
+#define HINT_DEDUCE_PER_TICK (256u)
 
 static void mine_sweeper_game_screen_action_callback(MineSweeperEvent event, void* context) {
     furi_assert(context);
@@ -122,6 +131,95 @@ static void process_feedback(
     }
 }
 
+static void mine_sweeper_hint_jump(MineSweeperApp* app) {
+    furi_assert(app);
+
+    uint16_t tile;
+    app->hint_jump_pending = false;
+
+    if (!hint_best_tile(app->hint, &tile, NULL)) {
+        mine_sweeper_oob_effect(app);
+        return;
+    }
+
+    const MineSweeperBoard* board = &app->game_state.board;
+    minesweeper_engine_set_cursor(&app->game_state, board_x(board, tile), board_y(board, tile));
+    mine_sweeper_move_effect(app);
+}
+
+static void mine_sweeper_step_hint(MineSweeperApp* app) {
+    furi_assert(app);
+
+    if (hint_step(app->hint, &app->game_state.board, HINT_WORK_PER_TICK) ==
+        MineSweeperHintPhaseRunning) {
+        return;
+    }
+
+    if (app->hint_jump_pending) {
+        mine_sweeper_hint_jump(app);
+    }
+
+    // Redraw with the finished hint
+    mine_sweeper_game_screen_set_hint(app->game_screen, app->hint);
+}
+
+// Holding OK on a hidden tile asks for a tile the player can be sure of, or
+// failing that the safest tile; that hint is worked out over the next ticks
+// unless it is already there for this board.
+static void mine_sweeper_request_hint(MineSweeperApp* app) {
+    furi_assert(app);
+
+    MineSweeperState* game_state = &app->game_state;
+    uint16_t tile;
+
+    hint_follow(app->hint, &game_state->board);
+    if (hint_sure_tile(
+            app->hint,
+            &game_state->board,
+            game_state->rt.cursor_col,
+            game_state->rt.cursor_row,
+            &tile,
+            NULL)) {
+        app->hint_jump_pending = false;
+        minesweeper_engine_set_cursor(
+            game_state, board_x(&game_state->board, tile), board_y(&game_state->board, tile));
+        mine_sweeper_move_effect(app);
+        mine_sweeper_game_screen_set_hint(app->game_screen, app->hint);
+        return;
+    }
+
+    if (app->hint->phase == MineSweeperHintPhaseIdle) {
+        hint_begin(app->hint, &app->game_state.board);
+    }
+
+    app->hint_jump_pending = true;
+    mine_sweeper_step_hint(app);
+}
+
+// Swaps the real mines in under the placeholder once the background job is done.
+static bool mine_sweeper_adopt_deferred_board(MineSweeperApp* app) {
+    furi_assert(app);
+
+    if (minesweeper_engine_generation_status(&app->generation_job) !=
+        MineSweeperGenerationStatusReady) {
+        return false;
+    }
+
+    // Ready means the thread is at most wrapping up its slice; try again next tick if so.
+    if (!mine_sweeper_worker_release_job(app->generation_worker)) {
+        return false;
+    }
+
+    uint8_t mines[BOARD_MINE_BITMAP_BYTES];
+    if (minesweeper_engine_generation_finish_mines(&app->generation_job, mines, false) !=
+        MineSweeperResultChanged) {
+        return false;
+    }
+
+    minesweeper_adopt_deferred_mines(app, mines);
+    return true;
+}
+
 static bool handle_playing_inputs(MineSweeperApp* app, SceneManagerEvent event) {
     MineSweeperAction action = {0};
 
@@ -155,10 +253,46 @@ static bool handle_playing_inputs(MineSweeperApp* app, SceneManagerEvent event)
         return false;
     }
 
+    const MineSweeperState* game_state = &app->game_state;
+    const bool on_revealed = CELL_IS_REVEALED(game_state->board.cells[board_index(
+        &game_state->board, game_state->rt.cursor_col, game_state->rt.cursor_row)]);
+
+    if (action.type == MineSweeperActionChord && !on_revealed) {
+        mine_sweeper_request_hint(app);
+        return true;
+    }
+
+    // The first reveal needs real mines; wait on the generating screen if they aren't in yet.
+    if (action.type == MineSweeperActionReveal && app->generation_deferred &&
+        !mine_sweeper_adopt_deferred_board(app)) {
+        app->deferred_reveal_pending = true;
+        app->generation_origin = MineSweeperGenerationOriginGame;
+        scene_manager_next_scene(app->scene_manager, MineSweeperSceneGenerating);
+        return true;
+    }
+
     MineSweeperActionResult result = minesweeper_engine_apply_action(&app->game_state, action);
 
+    // Flag on an open tile only moves the cursor
+    const bool board_changed = action.type != MineSweeperActionMove &&
+                               !(action.type == MineSweeperActionFlag && on_revealed) &&
+                               result.result != MineSweeperResultNoop;
+    if (board_changed) {
+        hint_reset(app->hint);
+        app->hint_jump_pending = false;
+        if (app->game_state.rt.phase == MineSweeperPhasePlaying) {
+            hint_follow(app->hint, &app->game_state.board);
+        }
+    }
+
     process_feedback(app, action.type, result);
 
+    // The player studies the final board for a while; use that time to top up
+    // the pool so OK on the game-over screen finds a board waiting.
+    if (result.result == MineSweeperResultWin || result.result == MineSweeperResultLose) {
+        mine_sweeper_worker_set_pool_config(app->generation_worker, &app->game_state.config);
+    }
+
     if (result.result != MineSweeperResultNoop) {
         // force redraw necessary??
     }
@@ -222,7 +356,29 @@ void minesweeper_scene_game_screen_on_enter(void* context) {
     mine_sweeper_game_screen_set_input_callback(
         app->game_screen, mine_sweeper_game_screen_action_callback, app);
 
+    // The hint state is large, so it only exists while this scene is up. A new
+    // one picks the game up from the board as it is now.
+    app->hint = malloc(sizeof(MineSweeperHintState));
+    furi_check(app->hint);
+    memset(app->hint, 0, sizeof(MineSweeperHintState));
+    app->hint_jump_pending = false;
+    if (app->game_state.rt.phase == MineSweeperPhasePlaying && !app->generation_deferred) {
+        hint_follow(app->hint, &app->game_state.board);
+    }
+    mine_sweeper_game_screen_set_hint(app->game_screen, app->hint);
+
     view_dispatcher_switch_to_view(app->view_dispatcher, MineSweeperGameScreenView);
+
+    // Back from waiting on a deferred board: carry out the reveal that sent us there.
+    if (app->deferred_reveal_pending && !app->generation_deferred) {
+        app->deferred_reveal_pending = false;
+
+        SceneManagerEvent reveal = {
+            .type = SceneManagerEventTypeCustom,
+            .event = MineSweeperEventShortOkPress,
+        };
+        handle_playing_inputs(app, reveal);
+    }
 }
 
 bool minesweeper_scene_game_screen_on_event(void* context, SceneManagerEvent event) {
@@ -242,6 +398,15 @@ bool minesweeper_scene_game_screen_on_event(void* context, SceneManagerEvent eve
     }
 
     if (event.type == SceneManagerEventTypeTick) {
+        if (app->generation_deferred) {
+            mine_sweeper_adopt_deferred_board(app);
+        }
+        if (app->hint->phase == MineSweeperHintPhaseRunning) {
+            mine_sweeper_step_hint(app);
+        }
+        if (app->game_state.rt.phase == MineSweeperPhasePlaying) {
+            hint_deduce_step(app->hint, &app->game_state.board, HINT_DEDUCE_PER_TICK);
+        }
         mine_sweeper_game_screen_update_clock(app->game_screen);
         return true;
     }
@@ -256,4 +421,9 @@ void minesweeper_scene_game_screen_on_exit(void* context) {
     // Keep the game-state context bound to avoid transient NULL deref during scene handoff.
     // Detach only the input callback owned by this scene.
     mine_sweeper_game_screen_set_input_callback(app->game_screen, NULL, NULL);
+
+    mine_sweeper_game_screen_set_hint(app->game_screen, NULL);
+    free(app->hint);
+    app->hint = NULL;
+    app->hint_jump_pending = false;
 }
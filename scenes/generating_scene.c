@@ -2,6 +2,7 @@
 #include "scenes/minesweeper_scene.h"
 #include "helpers/mine_sweeper_config.h"
 #include "helpers/mine_sweeper_led.h"
+#include "helpers/mine_sweeper_board_pack.h"
 
 #include <furi.h>
 
@@ -18,15 +19,7 @@ static void
 static MineSweeperConfig minesweeper_scene_generating_build_config(const MineSweeperApp* app) {
     furi_assert(app);
 
-    MineSweeperConfig config = {
-        .width = app->settings_committed.board_width,
-        .height = app->settings_committed.board_height,
-        .difficulty = app->settings_committed.difficulty,
-        .ensure_solvable = app->settings_committed.ensure_solvable_board,
-        .wrap_enabled = app->wrap_enabled,
-    };
-
-    return config;
+    return minesweeper_settings_to_config(app, &app->settings_committed);
 }
 
 static void minesweeper_scene_generating_update_stats(MineSweeperApp* app) {
@@ -37,8 +30,43 @@ static void minesweeper_scene_generating_update_stats(MineSweeperApp* app) {
         elapsed_seconds = (furi_get_tick() - app->generation_job.start_tick) / 1000u;
     }
 
+    const uint32_t eta_ms = minesweeper_engine_generation_eta_ms(&app->generation_job);
+    const uint32_t eta_seconds = eta_ms == UINT32_MAX ? UINT32_MAX : (eta_ms + 999u) / 1000u;
+
     minesweeper_generating_view_set_stats(
-        app->generating_view, app->generation_job.attempts_total, elapsed_seconds);
+        app->generating_view,
+        atomic_load(&app->generation_job.attempts_total),
+        elapsed_seconds,
+        eta_seconds);
+}
+
+static void minesweeper_scene_generating_enter_game(MineSweeperApp* app) {
+    furi_assert(app);
+
+    mine_sweeper_game_screen_set_context(app->game_screen, &app->game_state);
+    mine_sweeper_game_screen_reset_clock(app->game_screen);
+    scene_manager_next_scene(app->scene_manager, MineSweeperSceneGameScreen);
+}
+
+// Puts the finished board under the placeholder the player is already on and
+// goes back to it; the game scene then replays the reveal that brought us here.
+static void minesweeper_scene_generating_finalize_deferred(
+    MineSweeperApp* app,
+    bool allow_unsolved_fallback) {
+    furi_assert(app);
+
+    uint8_t mines[BOARD_MINE_BITMAP_BYTES];
+    if (minesweeper_engine_generation_finish_mines(
+            &app->generation_job, mines, allow_unsolved_fallback) != MineSweeperResultChanged) {
+        return;
+    }
+
+    minesweeper_adopt_deferred_mines(app, mines);
+
+    if (!scene_manager_search_and_switch_to_previous_scene(
+            app->scene_manager, MineSweeperSceneGameScreen)) {
+        scene_manager_next_scene(app->scene_manager, MineSweeperSceneGameScreen);
+    }
 }
 
 static void minesweeper_scene_generating_try_switch_to_game(
@@ -46,21 +74,27 @@ static void minesweeper_scene_generating_try_switch_to_game(
     bool allow_unsolved_fallback) {
     furi_assert(app);
 
+    mine_sweeper_worker_detach_job(app->generation_worker);
+
+    if (app->generation_deferred) {
+        minesweeper_scene_generating_finalize_deferred(app, allow_unsolved_fallback);
+        return;
+    }
+
     if (minesweeper_engine_generation_finish(
             &app->generation_job, &app->game_state, allow_unsolved_fallback) !=
         MineSweeperResultChanged) {
         return;
     }
 
-    mine_sweeper_game_screen_set_context(app->game_screen, &app->game_state);
-    mine_sweeper_game_screen_reset_clock(app->game_screen);
-    scene_manager_next_scene(app->scene_manager, MineSweeperSceneGameScreen);
+    minesweeper_scene_generating_enter_game(app);
 }
 
 static void minesweeper_scene_generating_cancel_and_return(MineSweeperApp* app) {
     furi_assert(app);
 
     minesweeper_engine_generation_cancel(&app->generation_job);
+    mine_sweeper_worker_detach_job(app->generation_worker);
 
     switch (app->generation_origin) {
     case MineSweeperGenerationOriginStart:
@@ -76,13 +110,52 @@ static void minesweeper_scene_generating_cancel_and_return(MineSweeperApp* app)
     }
 }
 
+static void minesweeper_scene_generating_show(MineSweeperApp* app) {
+    furi_assert(app);
+
+    minesweeper_generating_view_set_context(app->generating_view, app);
+    minesweeper_generating_view_set_input_callback(
+        app->generating_view, minesweeper_scene_generating_input_callback);
+    minesweeper_scene_generating_update_stats(app);
+
+    view_dispatcher_switch_to_view(app->view_dispatcher, MineSweeperGeneratingScreenView);
+}
+
 void minesweeper_scene_generating_on_enter(void* context) {
     furi_assert(context);
     MineSweeperApp* app = context;
 
     mine_sweeper_led_reset(app);
 
+    if (app->generation_deferred) {
+        const MineSweeperGenerationStatus status =
+            minesweeper_engine_generation_status(&app->generation_job);
+
+        // A reveal on the placeholder only has to wait for the job already running.
+        if (app->deferred_reveal_pending && (status == MineSweeperGenerationStatusInProgress ||
+                                             status == MineSweeperGenerationStatusReady)) {
+            app->generation_user_preempted = false;
+            minesweeper_scene_generating_show(app);
+            return;
+        }
+
+        // Otherwise a different board was asked for and the placeholder is abandoned.
+        minesweeper_engine_generation_cancel(&app->generation_job);
+        mine_sweeper_worker_detach_job(app->generation_worker);
+        app->generation_deferred = false;
+    }
+
     MineSweeperConfig config = minesweeper_scene_generating_build_config(app);
+
+    // A pregenerated board skips the generating screen entirely: the in-RAM pool
+    // first, then the SD card pack, and only then generate on the device.
+    mine_sweeper_worker_set_pool_config(app->generation_worker, &config);
+    if (mine_sweeper_worker_take_board(app->generation_worker, &config, &app->game_state) ||
+        mine_sweeper_board_pack_take(&config, &app->game_state)) {
+        minesweeper_scene_generating_enter_game(app);
+        return;
+    }
+
     if (minesweeper_engine_generation_begin(&app->generation_job, &config) ==
         MineSweeperResultInvalid) {
         FURI_LOG_E(TAG, "Failed to begin generation job");
@@ -91,13 +164,18 @@ void minesweeper_scene_generating_on_enter(void* context) {
     }
 
     app->generation_user_preempted = false;
+    mine_sweeper_worker_attach_job(app->generation_worker, &app->generation_job);
+
+    // Instant start: let the player look around a hidden board while the worker runs.
+    if (app->deferred_generation_enabled && !app->deferred_reveal_pending &&
+        minesweeper_engine_start_placeholder(&app->game_state, &config) ==
+            MineSweeperResultChanged) {
+        app->generation_deferred = true;
+        minesweeper_scene_generating_enter_game(app);
+        return;
+    }
 
-    minesweeper_generating_view_set_context(app->generating_view, app);
-    minesweeper_generating_view_set_input_callback(
-        app->generating_view, minesweeper_scene_generating_input_callback);
-    minesweeper_scene_generating_update_stats(app);
-
-    view_dispatcher_switch_to_view(app->view_dispatcher, MineSweeperGeneratingScreenView);
+    minesweeper_scene_generating_show(app);
 }
 
 bool minesweeper_scene_generating_on_event(void* context, SceneManagerEvent event) {
@@ -110,13 +188,20 @@ bool minesweeper_scene_generating_on_event(void* context, SceneManagerEvent even
     }
 
     if (event.type == SceneManagerEventTypeTick) {
+        // The worker thread does the generating; the tick only polls it.
         if (app->generation_user_preempted) {
-            if (!app->generation_job.has_latest_candidate) {
-                minesweeper_engine_generation_step(&app->generation_job, 1);
-                minesweeper_scene_generating_update_stats(app);
-                if (!app->generation_job.has_latest_candidate) {
-                    return true;
-                }
+            minesweeper_scene_generating_update_stats(app);
+
+            // The worker keeps the job until there is a board to start on; an
+            // attempt run here would freeze the screen for its whole length.
+            if (!minesweeper_engine_generation_has_forced_board(&app->generation_job)) {
+                minesweeper_generating_view_set_waiting(app->generating_view, true);
+                return true;
+            }
+
+            // Polled, so the screen stays responsive while the thread finishes an attempt.
+            if (!mine_sweeper_worker_release_job(app->generation_worker)) {
+                return true;
             }
 
             minesweeper_scene_generating_try_switch_to_game(app, true);
@@ -124,7 +209,7 @@ bool minesweeper_scene_generating_on_event(void* context, SceneManagerEvent even
         }
 
         MineSweeperGenerationStatus status =
-            minesweeper_engine_generation_step(&app->generation_job, 16);
+            minesweeper_engine_generation_status(&app->generation_job);
         minesweeper_scene_generating_update_stats(app);
 
         if (status == MineSweeperGenerationStatusReady) {
@@ -140,5 +225,6 @@ void minesweeper_scene_generating_on_exit(void* context) {
     furi_assert(context);
     MineSweeperApp* app = context;
 
+    mine_sweeper_worker_detach_job(app->generation_worker);
     minesweeper_generating_view_reset(app->generating_view);
 }
@@ -32,11 +32,32 @@ static const char* info_string = "--   GAME INFO BELOW   --\n\n"
                                  "enables a board verifier\n"
                                  "when generating a new\n"
                                  "board.\n\n"
+                                 "---    CLICKS (3BV)    ---\n"
+                                 "Only accepts boards that\n"
+                                 "need fewer, about the usual\n"
+                                 "or more clicks to clear\n"
+                                 "than others of the same\n"
+                                 "size and difficulty.\n"
+                                 "Changing it resets the\n"
+                                 "board.\n\n"
                                  "-----       WRAP       -----\n"
                                  "Enables wrapping player\n"
                                  "position to the other side\n"
                                  "of the screen if you move out\n"
                                  "of bounds.\n\n"
+                                 "---   INSTANT START   ---\n"
+                                 "Shows the board right away\n"
+                                 "while it is generated in\n"
+                                 "the background. Your first\n"
+                                 "clear waits for it if it\n"
+                                 "is not ready yet.\n\n"
+                                 "---    START CORNER    ---\n"
+                                 "The corner every new game\n"
+                                 "starts from; the cursor is\n"
+                                 "placed there. Solvable\n"
+                                 "boards are solvable from\n"
+                                 "it. Random picks one per\n"
+                                 "game.\n\n"
                                  "Enjoy the game and if you\n"
                                  "want to reach out about an\n"
                                  "issue go to the git hub repo\n"
@@ -9,6 +9,7 @@ typedef enum {
     MineSweeperSettingsScreenDifficultyTypeEasy,
     MineSweeperSettingsScreenDifficultyTypeMedium,
     MineSweeperSettingsScreenDifficultyTypeHard,
+    MineSweeperSettingsScreenDifficultyTypeExpert,
     MineSweeperSettingsScreenDifficultyTypeNum,
 } MineSweeperSettingsScreenDifficultyType;
 
@@ -17,15 +18,19 @@ typedef enum {
     MineSweeperSettingsScreenEventWidthChange,
     MineSweeperSettingsScreenEventHeightChange,
     MineSweeperSettingsScreenEventSolvableChange,
+    MineSweeperSettingsScreenEventClicksChange,
     MineSweeperSettingsScreenEventInfoChange,
     MineSweeperSettingsScreenEventFeedbackChange,
     MineSweeperSettingsScreenEventWrapChange,
+    MineSweeperSettingsScreenEventDeferredChange,
+    MineSweeperSettingsScreenEventCornerChange,
 } MineSweeperSettingsScreenEvent;
 
 static const char* settings_screen_difficulty_text[MineSweeperSettingsScreenDifficultyTypeNum] = {
     "Easy",
     "Medium",
     "Hard",
+    "Expert",
 };
 
 static const char* settings_screen_verifier_text[2] = {
@@ -33,6 +38,21 @@ static const char* settings_screen_verifier_text[2] = {
     "True",
 };
 
+static const char* settings_screen_clicks_text[MineSweeperClicksCount] = {
+    "Any",
+    "Fewer",
+    "Typical",
+    "More",
+};
+
+static const char* settings_screen_corner_text[MineSweeperStartCornerCount] = {
+    "Top Left",
+    "Top Right",
+    "Bot Left",
+    "Bot Right",
+    "Random",
+};
+
 static void minesweeper_scene_settings_screen_set_difficulty(VariableItem* item) {
     furi_assert(item);
 
@@ -113,6 +133,21 @@ static void minesweeper_scene_settings_screen_set_solvable(VariableItem* item) {
         app->view_dispatcher, MineSweeperSettingsScreenEventSolvableChange);
 }
 
+static void minesweeper_scene_settings_screen_set_clicks(VariableItem* item) {
+    furi_assert(item);
+
+    MineSweeperApp* app = variable_item_get_context(item);
+
+    uint8_t index = variable_item_get_current_value_index(app->settings_draft.clicks_item);
+
+    app->settings_draft.clicks_band = index;
+
+    variable_item_set_current_value_text(item, settings_screen_clicks_text[index]);
+
+    view_dispatcher_send_custom_event(
+        app->view_dispatcher, MineSweeperSettingsScreenEventClicksChange);
+}
+
 static void minesweeper_scene_settings_screen_set_feedback(VariableItem* item) {
     furi_assert(item);
 
@@ -143,6 +178,36 @@ static void minesweeper_scene_settings_screen_set_wrap(VariableItem* item) {
         app->view_dispatcher, MineSweeperSettingsScreenEventWrapChange);
 }
 
+static void minesweeper_scene_settings_screen_set_deferred(VariableItem* item) {
+    furi_assert(item);
+
+    MineSweeperApp* app = variable_item_get_context(item);
+
+    uint8_t value = variable_item_get_current_value_index(item);
+
+    app->deferred_generation_enabled = value;
+
+    variable_item_set_current_value_text(item, ((value) ? "Enabled" : "Disabled"));
+
+    view_dispatcher_send_custom_event(
+        app->view_dispatcher, MineSweeperSettingsScreenEventDeferredChange);
+}
+
+static void minesweeper_scene_settings_screen_set_corner(VariableItem* item) {
+    furi_assert(item);
+
+    MineSweeperApp* app = variable_item_get_context(item);
+
+    uint8_t value = variable_item_get_current_value_index(item);
+
+    app->start_corner = value;
+
+    variable_item_set_current_value_text(item, settings_screen_corner_text[value]);
+
+    view_dispatcher_send_custom_event(
+        app->view_dispatcher, MineSweeperSettingsScreenEventCornerChange);
+}
+
 static void minesweeper_scene_settings_screen_set_info(VariableItem* item) {
     furi_assert(item);
 
@@ -223,6 +288,21 @@ void minesweeper_scene_settings_screen_on_enter(void* context) {
 
     variable_item_set_current_value_text(item, settings_screen_verifier_text[idx]);
 
+    // Set clicks item
+    item = variable_item_list_add(
+        va,
+        "Clicks (3BV)",
+        MineSweeperClicksCount,
+        minesweeper_scene_settings_screen_set_clicks,
+        app);
+
+    app->settings_draft.clicks_item = item;
+
+    variable_item_set_current_value_index(item, app->settings_draft.clicks_band);
+
+    variable_item_set_current_value_text(
+        item, settings_screen_clicks_text[app->settings_draft.clicks_band]);
+
     // Set feedback item
     item = variable_item_list_add(
         va, "Feedback", 2, minesweeper_scene_settings_screen_set_feedback, app);
@@ -238,6 +318,27 @@ void minesweeper_scene_settings_screen_on_enter(void* context) {
 
     variable_item_set_current_value_text(item, ((app->wrap_enabled) ? "Enabled" : "Disabled"));
 
+    // Set instant start item
+    item = variable_item_list_add(
+        va, "Instant Start", 2, minesweeper_scene_settings_screen_set_deferred, app);
+
+    variable_item_set_current_value_index(item, app->deferred_generation_enabled);
+
+    variable_item_set_current_value_text(
+        item, ((app->deferred_generation_enabled) ? "Enabled" : "Disabled"));
+
+    // Set start corner item
+    item = variable_item_list_add(
+        va,
+        "Start Corner",
+        MineSweeperStartCornerCount,
+        minesweeper_scene_settings_screen_set_corner,
+        app);
+
+    variable_item_set_current_value_index(item, app->start_corner);
+
+    variable_item_set_current_value_text(item, settings_screen_corner_text[app->start_corner]);
+
     // Set info item
     item = variable_item_list_add(
         va, "Right For Info", 2, minesweeper_scene_settings_screen_set_info, app);
@@ -256,30 +357,28 @@ bool minesweeper_scene_settings_screen_on_event(void* context, SceneManagerEvent
     bool consumed = false;
 
     if (event.type == SceneManagerEventTypeCustom) {
-        // Only these fields require reset confirmation; wrap/feedback are immediate-save.
+        // Only these fields require reset confirmation; the toggles below them are immediate-save.
         app->is_settings_changed =
             (app->settings_committed.board_width != app->settings_draft.board_width ||
              app->settings_committed.board_height != app->settings_draft.board_height ||
              app->settings_committed.difficulty != app->settings_draft.difficulty ||
              app->settings_committed.ensure_solvable_board !=
-                 app->settings_draft.ensure_solvable_board);
+                 app->settings_draft.ensure_solvable_board ||
+             app->settings_committed.clicks_band != app->settings_draft.clicks_band);
 
         switch (event.event) {
         case MineSweeperSettingsScreenEventDifficultyChange:
-
-            break;
-
         case MineSweeperSettingsScreenEventWidthChange:
-
-            break;
-
         case MineSweeperSettingsScreenEventHeightChange:
-
-            break;
-
         case MineSweeperSettingsScreenEventSolvableChange:
-
+        case MineSweeperSettingsScreenEventClicksChange: {
+            // The draft is the most likely next board, so start pregenerating it now.
+            // If it is saved the generating screen is skipped; a cancel retargets back.
+            MineSweeperConfig config =
+                minesweeper_settings_to_config(app, &app->settings_draft);
+            mine_sweeper_worker_set_pool_config(app->generation_worker, &config);
             break;
+        }
 
         case MineSweeperSettingsScreenEventInfoChange:
 
@@ -298,7 +397,21 @@ bool minesweeper_scene_settings_screen_on_event(void* context, SceneManagerEvent
             }
             break;
 
+        case MineSweeperSettingsScreenEventCornerChange:
+            mine_sweeper_save_settings(app);
+            {
+                // Takes effect from the next board; pooled boards are turned when taken.
+                MineSweeperConfig config = app->game_state.config;
+                config.start_corner = app->start_corner;
+                if (minesweeper_engine_set_config(&app->game_state, &config) ==
+                    MineSweeperResultInvalid) {
+                    FURI_LOG_E(TAG, "Failed to apply start corner setting to engine");
+                }
+            }
+            break;
+
         case MineSweeperSettingsScreenEventFeedbackChange:
+        case MineSweeperSettingsScreenEventDeferredChange:
             mine_sweeper_save_settings(app);
             break;
 
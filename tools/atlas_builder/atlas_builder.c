@@ -0,0 +1,325 @@
+/* Host side solvability atlas builder.
+ *
+ * Measures, for every grid size and difficulty in engine/mine_sweeper_atlas.c,
+ * how often each generation strategy gives a board solvable from the top left
+ * tile and what one attempt costs, using the same engine/ sources the app
+ * runs. The result is written as engine/mine_sweeper_atlas_table.c.
+ *
+ * Cells are handed out to worker threads through a shared counter. Each cell
+ * runs until it has seen enough solvable boards or used up its time budget,
+ * so cells where a strategy almost never succeeds (Expert by rejection) stay
+ * bounded and come out as 0.
+ */
+
+#include "furi.h"
+#include "furi_hal.h"
+
+#include "mine_sweeper_atlas.h"
+#include "mine_sweeper_engine.h"
+#include "mine_sweeper_solver.h"
+#include "mine_sweeper_strategy.h"
+
+#include <inttypes.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define ATLAS_CELL_COUNT \
+    (MINESWEEPER_DIFFICULTY_COUNT * MINESWEEPER_ATLAS_HEIGHT_COUNT * MINESWEEPER_ATLAS_WIDTH_COUNT)
+#define ATLAS_MAX_THREADS     (256u)
+#define ATLAS_TARGET_ACCEPTED (64u)
+#define ATLAS_MIN_ATTEMPTS    (16u)
+#define ATLAS_DEFAULT_SECONDS (2.0)
+
+typedef struct {
+    uint32_t attempts;
+    uint32_t accepted;
+    uint64_t busy_ns;
+} AtlasSample;
+
+typedef struct {
+    MineSweeperConfig config;
+    uint16_t mine_count;
+    AtlasSample samples[MineSweeperStrategyCount];
+} AtlasCell;
+
+typedef struct {
+    AtlasCell cells[ATLAS_CELL_COUNT];
+    uint64_t budget_ns;
+    uint64_t seed;
+    atomic_uint_fast32_t next_cell;
+    atomic_uint_fast32_t cells_done;
+} Atlas;
+
+static uint64_t atlas_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+// One attempt as the engine makes it, reporting whether it gave a solvable board.
+static bool atlas_attempt(const AtlasCell* cell, MineSweeperStrategy strategy) {
+    const MineSweeperStrategyOps* ops = minesweeper_strategy_ops(strategy);
+    MineSweeperBoard board;
+    board_init(&board, cell->config.width, cell->config.height);
+
+    uint16_t cleared = 0;
+    const bool solvable = ops->place(&board, cell->mine_count, &cleared);
+    return ops->self_verifying ? solvable : check_board_with_solver(&board);
+}
+
+static void atlas_measure(Atlas* atlas, AtlasCell* cell, MineSweeperStrategy strategy) {
+    AtlasSample* sample = &cell->samples[strategy];
+    const uint64_t start = atlas_now_ns();
+    uint64_t elapsed = 0;
+
+    while (sample->accepted < ATLAS_TARGET_ACCEPTED &&
+           (sample->attempts < ATLAS_MIN_ATTEMPTS || elapsed < atlas->budget_ns)) {
+        sample->accepted += atlas_attempt(cell, strategy) ? 1u : 0u;
+        sample->attempts++;
+        elapsed = atlas_now_ns() - start;
+    }
+
+    sample->busy_ns = elapsed;
+}
+
+static void* atlas_worker(void* context) {
+    Atlas* atlas = context;
+
+    for (;;) {
+        const uint32_t index = (uint32_t)atomic_fetch_add(&atlas->next_cell, 1u);
+        if (index >= ATLAS_CELL_COUNT) break;
+
+        // Seeded per cell, so a cell draws the same boards whichever thread takes it.
+        furi_hal_random_seed(atlas->seed ^ (0x9E3779B97F4A7C15ull * (index + 1u)));
+
+        AtlasCell* cell = &atlas->cells[index];
+        for (uint8_t s = 0; s < MineSweeperStrategyCount; ++s) {
+            atlas_measure(atlas, cell, (MineSweeperStrategy)s);
+        }
+
+        const uint32_t done = (uint32_t)atomic_fetch_add(&atlas->cells_done, 1u) + 1u;
+        fprintf(stderr, "\r%" PRIu32 "/%u cells", done, ATLAS_CELL_COUNT);
+    }
+
+    return NULL;
+}
+
+static uint16_t atlas_accept_q16(const AtlasSample* sample) {
+    if (sample->accepted == 0) return 0;
+
+    const double q16 = (double)sample->accepted * 65536.0 / sample->attempts + 0.5;
+    // Seen at least once, so never round down to "never".
+    if (q16 < 1.0) return 1;
+    return q16 > 65535.0 ? 65535u : (uint16_t)q16;
+}
+
+static uint16_t atlas_cost_us_q2(const AtlasSample* sample) {
+    const double q2 = (double)sample->busy_ns * 4.0 / 1000.0 / sample->attempts + 0.5;
+    if (q2 < 1.0) return 1;
+    return q2 > 65535.0 ? 65535u : (uint16_t)q2;
+}
+
+static bool atlas_write_table(const Atlas* atlas, const char* path, double seconds) {
+    FILE* file = fopen(path, "w");
+    if (!file) {
+        fprintf(stderr, "cannot open %s\n", path);
+        return false;
+    }
+
+    fprintf(
+        file,
+        "// Generated by tools/atlas_builder (up to %u solvable boards or %.1fs per\n"
+        "// strategy and cell); do not edit. Entries are\n"
+        "// {{rejection, constructive} accept_q16}, {{rejection, constructive} cost_us_q2}.\n"
+        "\n"
+        "#include \"mine_sweeper_atlas.h\"\n"
+        "\n"
+        "const MineSweeperAtlasEntry minesweeper_atlas_table[MINESWEEPER_DIFFICULTY_COUNT]\n"
+        "                                                   [MINESWEEPER_ATLAS_HEIGHT_COUNT]\n"
+        "                                                   [MINESWEEPER_ATLAS_WIDTH_COUNT] = {\n",
+        ATLAS_TARGET_ACCEPTED,
+        seconds);
+
+    uint32_t index = 0;
+    for (uint8_t d = 0; d < MINESWEEPER_DIFFICULTY_COUNT; ++d) {
+        fprintf(file, "    {\n");
+        for (uint8_t y = 0; y < MINESWEEPER_ATLAS_HEIGHT_COUNT; ++y) {
+            fprintf(file, "        {\n");
+            for (uint8_t x = 0; x < MINESWEEPER_ATLAS_WIDTH_COUNT; ++x, ++index) {
+                const AtlasCell* cell = &atlas->cells[index];
+                fprintf(
+                    file,
+                    "            {{%u, %u}, {%u, %u}}, // %ux%u\n",
+                    atlas_accept_q16(&cell->samples[MineSweeperStrategyRejection]),
+                    atlas_accept_q16(&cell->samples[MineSweeperStrategyConstructive]),
+                    atlas_cost_us_q2(&cell->samples[MineSweeperStrategyRejection]),
+                    atlas_cost_us_q2(&cell->samples[MineSweeperStrategyConstructive]),
+                    cell->config.width,
+                    cell->config.height);
+            }
+            fprintf(file, "        },\n");
+        }
+        fprintf(file, "    },\n");
+    }
+
+    fprintf(file, "};\n");
+
+    const bool ok = fclose(file) == 0;
+    if (!ok) fprintf(stderr, "failed writing %s\n", path);
+    return ok;
+}
+
+static void atlas_report(const Atlas* atlas) {
+    printf("\n%-8s %-6s %12s %12s %14s\n", "size", "level", "rejection", "constructive", "picked");
+
+    for (uint32_t i = 0; i < ATLAS_CELL_COUNT; ++i) {
+        const AtlasCell* cell = &atlas->cells[i];
+        MineSweeperAtlasEstimate estimate;
+        char size[16];
+        char rates[MineSweeperStrategyCount][16];
+
+        for (uint8_t s = 0; s < MineSweeperStrategyCount; ++s) {
+            const AtlasSample* sample = &cell->samples[s];
+            estimate.accept[s] = (float)sample->accepted / (float)sample->attempts;
+            estimate.cost_us[s] = (float)sample->busy_ns / 1000.0f / (float)sample->attempts;
+            snprintf(
+                rates[s],
+                sizeof(rates[s]),
+                "%" PRIu32 "/%" PRIu32,
+                sample->accepted,
+                sample->attempts);
+        }
+
+        snprintf(size, sizeof(size), "%ux%u", cell->config.width, cell->config.height);
+        printf(
+            "%-8s %-6u %12s %12s %14s\n",
+            size,
+            cell->config.difficulty,
+            rates[MineSweeperStrategyRejection],
+            rates[MineSweeperStrategyConstructive],
+            minesweeper_strategy_ops(minesweeper_atlas_pick_strategy(&estimate))->name);
+    }
+}
+
+static void atlas_report_prefilter(void) {
+    static const char* const reasons[MineSweeperPrefilterCount] = {
+        [MineSweeperPrefilterPass] = "passed",
+        [MineSweeperPrefilterStartNumber] = "start number",
+        [MineSweeperPrefilterSealedPocket] = "sealed pocket",
+        [MineSweeperPrefilterFiftyFifty] = "50/50",
+    };
+    uint32_t counts[MineSweeperPrefilterCount];
+    uint64_t total = 0;
+
+    solver_prefilter_counts(counts);
+    for (uint8_t i = 0; i < MineSweeperPrefilterCount; ++i) {
+        total += counts[i];
+    }
+    if (total == 0) return;
+
+    printf("prefilter over %" PRIu64 " boards:", total);
+    for (uint8_t i = 0; i < MineSweeperPrefilterCount; ++i) {
+        printf(" %s %.1f%%", reasons[i], 100.0 * counts[i] / (double)total);
+    }
+    printf("\n");
+}
+
+static void atlas_usage(const char* argv0) {
+    fprintf(
+        stderr,
+        "usage: %s [-o mine_sweeper_atlas_table.c] [-t seconds] [-j threads] [-s seed]\n"
+        "\n"
+        "  -o  output path (default ../../engine/mine_sweeper_atlas_table.c)\n"
+        "  -t  time budget per strategy and cell (default %.1f)\n"
+        "  -j  worker threads (default: all online cores)\n"
+        "  -s  random seed (default: time based)\n",
+        argv0,
+        ATLAS_DEFAULT_SECONDS);
+}
+
+int main(int argc, char** argv) {
+    const char* output = "../../engine/mine_sweeper_atlas_table.c";
+    double seconds = ATLAS_DEFAULT_SECONDS;
+    long online = sysconf(_SC_NPROCESSORS_ONLN);
+    uint32_t thread_count = online > 0 ? (uint32_t)online : 1u;
+    uint64_t seed = atlas_now_ns() ^ ((uint64_t)getpid() << 32);
+    int opt;
+
+    while ((opt = getopt(argc, argv, "o:t:j:s:h")) != -1) {
+        switch (opt) {
+        case 'o':
+            output = optarg;
+            break;
+        case 't':
+            seconds = strtod(optarg, NULL);
+            break;
+        case 'j':
+            thread_count = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case 's':
+            seed = strtoull(optarg, NULL, 0);
+            break;
+        default:
+            atlas_usage(argv[0]);
+            return opt == 'h' ? 0 : 2;
+        }
+    }
+
+    if (optind != argc || seconds <= 0.0 || thread_count == 0 ||
+        thread_count > ATLAS_MAX_THREADS) {
+        atlas_usage(argv[0]);
+        return 2;
+    }
+
+    Atlas* atlas = calloc(1, sizeof(Atlas));
+    furi_check(atlas);
+    atlas->budget_ns = (uint64_t)(seconds * 1e9);
+    atlas->seed = seed;
+    atomic_init(&atlas->next_cell, 0u);
+    atomic_init(&atlas->cells_done, 0u);
+
+    uint32_t index = 0;
+    for (uint8_t d = 0; d < MINESWEEPER_DIFFICULTY_COUNT; ++d) {
+        for (uint8_t y = 0; y < MINESWEEPER_ATLAS_HEIGHT_COUNT; ++y) {
+            for (uint8_t x = 0; x < MINESWEEPER_ATLAS_WIDTH_COUNT; ++x, ++index) {
+                AtlasCell* cell = &atlas->cells[index];
+                cell->config = (MineSweeperConfig){
+                    .width = minesweeper_atlas_widths[x],
+                    .height = minesweeper_atlas_heights[y],
+                    .difficulty = d,
+                    .ensure_solvable = true,
+                };
+
+                cell->mine_count = minesweeper_engine_mine_count(&cell->config);
+            }
+        }
+    }
+
+    pthread_t threads[ATLAS_MAX_THREADS];
+    const uint64_t start = atlas_now_ns();
+    for (uint32_t t = 0; t < thread_count; ++t) {
+        furi_check(pthread_create(&threads[t], NULL, atlas_worker, atlas) == 0);
+    }
+    for (uint32_t t = 0; t < thread_count; ++t) {
+        pthread_join(threads[t], NULL);
+    }
+
+    atlas_report(atlas);
+    printf(
+        "\n%u cells in %.1fs on %" PRIu32 " threads\n",
+        ATLAS_CELL_COUNT,
+        (double)(atlas_now_ns() - start) / 1e9,
+        thread_count);
+    atlas_report_prefilter();
+
+    const bool ok = atlas_write_table(atlas, output, seconds);
+    if (ok) printf("wrote %s\n", output);
+
+    free(atlas);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,680 @@
+/* Host side board pack builder.
+ *
+ * Generates solvable boards with the same engine/ sources the app runs,
+ * re-verifies each one, drops duplicates (including boards that are a
+ * reflection or rotation of one already kept) and writes a v2 board pack that
+ * helpers/mine_sweeper_board_pack.c can read straight off the SD card.
+ *
+ * Every group is split into small tasks which are dealt round robin onto one
+ * deque per worker thread. A worker pops from the back of its own deque and,
+ * once that runs dry, steals from the front of the others, so groups that are
+ * much slower to fill (large Hard boards take ~1500 attempts each) never leave
+ * cores idle while a single thread grinds through them.
+ */
+
+#include "furi.h"
+#include "furi_hal.h"
+
+#include "mine_sweeper_board_pack_format.h"
+#include "mine_sweeper_codec.h"
+#include "mine_sweeper_engine.h"
+#include "mine_sweeper_solver.h"
+
+#include <errno.h>
+#include <inttypes.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <time.h>
+#include <unistd.h>
+
+#define BUILDER_TASK_BOARDS        (8u)
+#define BUILDER_MAX_THREADS        (256u)
+#define BUILDER_GENERATION_BATCH   (64u)
+// A group whose layouts keep repeating this often in a row is smaller than asked for.
+#define BUILDER_MAX_DUPLICATE_RUN  (1000u)
+#define BUILDER_DEFAULT_BOARDS     (256u)
+
+static const char* const difficulty_names[MINESWEEPER_DIFFICULTY_COUNT] = {
+    "easy",
+    "medium",
+    "hard",
+    "expert",
+};
+
+typedef struct {
+    MineSweeperConfig config;
+    uint32_t target;
+    uint16_t tile_count;
+
+    pthread_mutex_t lock;
+    // Guarded by lock
+    uint32_t accepted;
+    uint32_t duplicates;
+    uint32_t duplicate_run;
+    bool exhausted;
+    uint16_t mine_count;
+    uint64_t* hashes; // open addressing, 0 marks an empty slot
+    uint32_t hash_mask;
+    uint8_t* encoded; // target slots of BOARD_CODEC_MAX_BYTES
+    uint16_t* encoded_sizes;
+    uint64_t busy_ns; // worker time spent on this group, summed over threads
+    uint64_t attempts;
+} BuilderGroup;
+
+typedef struct {
+    uint32_t group;
+    uint32_t boards;
+} BuilderTask;
+
+typedef struct {
+    pthread_mutex_t lock;
+    BuilderTask* tasks;
+    uint32_t head;
+    uint32_t tail;
+    uint32_t capacity;
+} BuilderDeque;
+
+typedef struct {
+    BuilderGroup* groups;
+    uint32_t group_count;
+    BuilderDeque* deques;
+    uint32_t thread_count;
+    uint64_t seed;
+    atomic_bool failed;
+    atomic_uint_fast32_t boards_done;
+    uint32_t boards_total;
+} Builder;
+
+typedef struct {
+    Builder* builder;
+    uint32_t index;
+    uint32_t steals;
+} BuilderWorker;
+
+static uint64_t builder_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+// FNV-1a over the packed layout, never 0 so 0 can mark empty hash slots.
+static uint64_t builder_hash_mines(const uint8_t* mines, uint16_t tile_count) {
+    uint64_t hash = 0xCBF29CE484222325ull;
+    const uint16_t bytes = (uint16_t)((tile_count + 7u) / 8u);
+    for (uint16_t i = 0; i < bytes; ++i) {
+        hash ^= mines[i];
+        hash *= 0x100000001B3ull;
+    }
+    return hash ? hash : 1u;
+}
+
+// The device plays every reflection and rotation of a stored board, so two boards
+// that are transforms of each other count as duplicates: hash the smallest variant.
+static uint64_t builder_hash_board(const uint8_t* mines, uint8_t width, uint8_t height) {
+    const uint16_t tile_count = (uint16_t)width * height;
+    uint64_t hash = UINT64_MAX;
+
+    for (uint8_t t = 0; t < board_transform_count(width, height); ++t) {
+        uint8_t variant[BOARD_MINE_BITMAP_BYTES];
+        board_transform_mines(mines, width, height, (MineSweeperTransform)t, variant);
+        const uint64_t variant_hash = builder_hash_mines(variant, tile_count);
+        if (variant_hash < hash) hash = variant_hash;
+    }
+
+    return hash;
+}
+
+static uint16_t builder_count_mines(const uint8_t* mines, uint16_t tile_count) {
+    uint16_t count = 0;
+    for (uint16_t i = 0; i < tile_count; ++i) {
+        count += (mines[i >> 3] >> (i & 7u)) & 1u;
+    }
+    return count;
+}
+
+/* ---- Deques ---- */
+
+static void builder_deque_push(BuilderDeque* deque, BuilderTask task) {
+    if (deque->tail == deque->capacity) {
+        deque->capacity = deque->capacity ? deque->capacity * 2u : 64u;
+        deque->tasks = realloc(deque->tasks, deque->capacity * sizeof(BuilderTask));
+        furi_check(deque->tasks);
+    }
+    deque->tasks[deque->tail++] = task;
+}
+
+// The owner works from the back of its own deque.
+static bool builder_deque_pop_back(BuilderDeque* deque, BuilderTask* task) {
+    pthread_mutex_lock(&deque->lock);
+    const bool found = deque->tail > deque->head;
+    if (found) *task = deque->tasks[--deque->tail];
+    pthread_mutex_unlock(&deque->lock);
+    return found;
+}
+
+// Thieves take from the front, away from the owner.
+static bool builder_deque_steal_front(BuilderDeque* deque, BuilderTask* task) {
+    pthread_mutex_lock(&deque->lock);
+    const bool found = deque->tail > deque->head;
+    if (found) *task = deque->tasks[deque->head++];
+    pthread_mutex_unlock(&deque->lock);
+    return found;
+}
+
+static bool builder_next_task(BuilderWorker* worker, BuilderTask* task) {
+    Builder* builder = worker->builder;
+
+    if (builder_deque_pop_back(&builder->deques[worker->index], task)) {
+        return true;
+    }
+
+    // Tasks are only ever dealt out up front, so one empty sweep means we are done.
+    const uint32_t start = furi_hal_random_get() % builder->thread_count;
+    for (uint32_t i = 0; i < builder->thread_count; ++i) {
+        const uint32_t victim = (start + i) % builder->thread_count;
+        if (victim == worker->index) continue;
+        if (builder_deque_steal_front(&builder->deques[victim], task)) {
+            worker->steals++;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/* ---- Groups ---- */
+
+typedef enum {
+    BuilderAddAccepted,
+    BuilderAddDuplicate,
+    BuilderAddGroupDone,
+} BuilderAddResult;
+
+static BuilderAddResult builder_group_add(
+    BuilderGroup* group,
+    const uint8_t* mines,
+    const uint8_t* encoded,
+    uint16_t encoded_size,
+    uint64_t elapsed_ns,
+    uint32_t attempts) {
+    const uint64_t hash =
+        builder_hash_board(mines, group->config.width, group->config.height);
+    BuilderAddResult result = BuilderAddAccepted;
+
+    pthread_mutex_lock(&group->lock);
+    group->busy_ns += elapsed_ns;
+    group->attempts += attempts;
+
+    if (group->exhausted || group->accepted >= group->target) {
+        result = BuilderAddGroupDone;
+    } else {
+        uint32_t slot = (uint32_t)hash & group->hash_mask;
+        while (group->hashes[slot] != 0 && group->hashes[slot] != hash) {
+            slot = (slot + 1u) & group->hash_mask;
+        }
+
+        if (group->hashes[slot] == hash) {
+            group->duplicates++;
+            if (++group->duplicate_run >= BUILDER_MAX_DUPLICATE_RUN) {
+                group->exhausted = true;
+                result = BuilderAddGroupDone;
+            } else {
+                result = BuilderAddDuplicate;
+            }
+        } else {
+            group->hashes[slot] = hash;
+            group->duplicate_run = 0;
+            memcpy(
+                group->encoded + (size_t)group->accepted * BOARD_CODEC_MAX_BYTES,
+                encoded,
+                encoded_size);
+            group->encoded_sizes[group->accepted] = encoded_size;
+            group->accepted++;
+        }
+    }
+
+    pthread_mutex_unlock(&group->lock);
+    return result;
+}
+
+// Generates one board for the group and checks it the way the device would load it.
+static bool builder_generate_board(
+    MineSweeperGenerationJob* job,
+    BuilderGroup* group,
+    uint8_t* mines,
+    uint8_t* encoded,
+    uint16_t* encoded_size,
+    uint32_t* attempts) {
+    if (minesweeper_engine_generation_begin(job, &group->config) != MineSweeperResultChanged) {
+        return false;
+    }
+
+    while (minesweeper_engine_generation_step(job, BUILDER_GENERATION_BATCH) ==
+           MineSweeperGenerationStatusInProgress) {
+    }
+
+    *attempts = (uint32_t)atomic_load(&job->attempts_total);
+
+    memset(mines, 0, BOARD_MINE_BITMAP_BYTES);
+    if (minesweeper_engine_generation_finish_mines(job, mines, false) !=
+        MineSweeperResultChanged) {
+        return false;
+    }
+
+    // Re-verify independently of the generation path.
+    MineSweeperBoard board;
+    board_unpack_mines(&board, group->config.width, group->config.height, mines);
+    if (!check_board_with_solver(&board)) {
+        return false;
+    }
+
+    const uint16_t mine_count = builder_count_mines(mines, group->tile_count);
+    if (mine_count != group->mine_count) {
+        return false;
+    }
+
+    if (!board_codec_encode(
+           mines, group->tile_count, mine_count, encoded, BOARD_CODEC_MAX_BYTES, encoded_size)) {
+        return false;
+    }
+
+    uint8_t decoded[BOARD_MINE_BITMAP_BYTES] = {0};
+    board_codec_decode(encoded, *encoded_size, group->tile_count, mine_count, decoded);
+    return memcmp(decoded, mines, (group->tile_count + 7u) / 8u) == 0;
+}
+
+static void* builder_worker_thread(void* context) {
+    BuilderWorker* worker = context;
+    Builder* builder = worker->builder;
+
+    furi_hal_random_seed(builder->seed ^ (0x9E3779B97F4A7C15ull * (worker->index + 1u)));
+
+    MineSweeperGenerationJob* job = malloc(sizeof(MineSweeperGenerationJob));
+    furi_check(job);
+
+    uint8_t mines[BOARD_MINE_BITMAP_BYTES];
+    uint8_t encoded[BOARD_CODEC_MAX_BYTES];
+    BuilderTask task;
+
+    while (!atomic_load(&builder->failed) && builder_next_task(worker, &task)) {
+        BuilderGroup* group = &builder->groups[task.group];
+        uint32_t remaining = task.boards;
+
+        while (remaining > 0 && !atomic_load(&builder->failed)) {
+            const uint64_t started = builder_now_ns();
+            uint16_t encoded_size = 0;
+            uint32_t attempts = 0;
+
+            if (!builder_generate_board(job, group, mines, encoded, &encoded_size, &attempts)) {
+                fprintf(
+                    stderr,
+                    "board failed verification for %ux%u %s\n",
+                    group->config.width,
+                    group->config.height,
+                    difficulty_names[group->config.difficulty]);
+                atomic_store(&builder->failed, true);
+                break;
+            }
+
+            const BuilderAddResult result = builder_group_add(
+                group, mines, encoded, encoded_size, builder_now_ns() - started, attempts);
+
+            if (result == BuilderAddGroupDone) break;
+            if (result == BuilderAddAccepted) {
+                remaining--;
+                atomic_fetch_add(&builder->boards_done, 1u);
+            }
+        }
+    }
+
+    free(job);
+    return NULL;
+}
+
+/* ---- Pack output ---- */
+
+static uint16_t builder_group_stride(const BuilderGroup* group) {
+    uint16_t stride = 0;
+    for (uint32_t i = 0; i < group->accepted; ++i) {
+        if (group->encoded_sizes[i] > stride) stride = group->encoded_sizes[i];
+    }
+    return stride;
+}
+
+static bool builder_write_pack(const Builder* builder, const char* path) {
+    FILE* file = fopen(path, "wb");
+    if (!file) {
+        fprintf(stderr, "cannot open %s: %s\n", path, strerror(errno));
+        return false;
+    }
+
+    // pack_id follows the contents, so any rebuild resets the cursors on the device.
+    uint32_t pack_id = 0x811C9DC5u;
+    uint32_t offset = BOARD_PACK_HEADER_SIZE + builder->group_count * BOARD_PACK_GROUP_SIZE;
+    uint8_t raw[BOARD_PACK_HEADER_SIZE];
+    bool ok = true;
+
+    for (uint32_t g = 0; g < builder->group_count; ++g) {
+        const BuilderGroup* group = &builder->groups[g];
+        for (uint32_t i = 0; i < group->accepted; ++i) {
+            const uint8_t* slot = group->encoded + (size_t)i * BOARD_CODEC_MAX_BYTES;
+            for (uint16_t b = 0; b < group->encoded_sizes[i]; ++b) {
+                pack_id = (pack_id ^ slot[b]) * 0x01000193u;
+            }
+        }
+    }
+
+    const BoardPackHeader header = {
+        .version = BOARD_PACK_VERSION,
+        .group_count = (uint16_t)builder->group_count,
+        .pack_id = pack_id,
+    };
+    board_pack_write_header(raw, &header);
+    ok = ok && fwrite(raw, 1, BOARD_PACK_HEADER_SIZE, file) == BOARD_PACK_HEADER_SIZE;
+
+    for (uint32_t g = 0; g < builder->group_count; ++g) {
+        const BuilderGroup* group = &builder->groups[g];
+        const BoardPackGroup entry = {
+            .width = group->config.width,
+            .height = group->config.height,
+            .difficulty = group->config.difficulty,
+            .board_stride = builder_group_stride(group),
+            .mine_count = group->mine_count,
+            .board_count = group->accepted,
+            .offset = offset,
+        };
+        board_pack_write_group(raw, &entry);
+        ok = ok && fwrite(raw, 1, BOARD_PACK_GROUP_SIZE, file) == BOARD_PACK_GROUP_SIZE;
+        offset += entry.board_stride * entry.board_count;
+    }
+
+    for (uint32_t g = 0; g < builder->group_count; ++g) {
+        const BuilderGroup* group = &builder->groups[g];
+        const uint16_t stride = builder_group_stride(group);
+        for (uint32_t i = 0; i < group->accepted && ok; ++i) {
+            uint8_t slot[BOARD_CODEC_MAX_BYTES] = {0};
+            memcpy(
+                slot,
+                group->encoded + (size_t)i * BOARD_CODEC_MAX_BYTES,
+                group->encoded_sizes[i]);
+            ok = fwrite(slot, 1, stride, file) == stride;
+        }
+    }
+
+    if (fclose(file) != 0) ok = false;
+    if (!ok) fprintf(stderr, "failed writing %s\n", path);
+    return ok;
+}
+
+/* ---- Command line ---- */
+
+static void builder_usage(const char* argv0) {
+    fprintf(
+        stderr,
+        "usage: %s [-o boards.pack] [-n boards] [-j threads] [-s seed] WxH:difficulty...\n"
+        "\n"
+        "  -o  output path (default boards.pack)\n"
+        "  -n  boards per group (default %u)\n"
+        "  -j  worker threads (default: all online cores)\n"
+        "  -s  random seed (default: time based)\n"
+        "\n"
+        "difficulty is easy, medium, hard, expert or 0-%u. Every group is\n"
+        "generated as if Ensure Solvable were on, e.g. 32x32:hard 16x7:easy\n",
+        argv0,
+        BUILDER_DEFAULT_BOARDS,
+        MINESWEEPER_DIFFICULTY_COUNT - 1);
+}
+
+static bool builder_parse_group(const char* spec, MineSweeperConfig* config) {
+    unsigned width = 0, height = 0;
+    char difficulty[16] = {0};
+
+    if (sscanf(spec, "%ux%u:%15s", &width, &height, difficulty) != 3) return false;
+    if (width < 1 || width > BOARD_MAX_WIDTH || height < 1 || height > BOARD_MAX_HEIGHT) {
+        return false;
+    }
+
+    int level = -1;
+    for (unsigned i = 0; i < MINESWEEPER_DIFFICULTY_COUNT; ++i) {
+        if (strcasecmp(difficulty, difficulty_names[i]) == 0) level = (int)i;
+    }
+    if (level < 0 && difficulty[1] == '\0' && difficulty[0] >= '0' &&
+        difficulty[0] < (char)('0' + MINESWEEPER_DIFFICULTY_COUNT)) {
+        level = difficulty[0] - '0';
+    }
+    if (level < 0) return false;
+
+    memset(config, 0, sizeof(*config));
+    config->width = (uint8_t)width;
+    config->height = (uint8_t)height;
+    config->difficulty = (uint8_t)level;
+    config->ensure_solvable = true;
+    return true;
+}
+
+static bool builder_group_init(BuilderGroup* group, const MineSweeperConfig* config, uint32_t n) {
+    memset(group, 0, sizeof(*group));
+    group->config = *config;
+    group->target = n;
+    group->tile_count = (uint16_t)config->width * config->height;
+
+    // The engine owns the density table; ask it for the mine count of this config.
+    MineSweeperState probe;
+    if (minesweeper_engine_start_placeholder(&probe, config) != MineSweeperResultChanged) {
+        return false;
+    }
+    group->mine_count = probe.board.mine_count;
+
+    uint32_t hash_capacity = 16u;
+    while (hash_capacity < n * 2u) hash_capacity <<= 1;
+    group->hash_mask = hash_capacity - 1u;
+    group->hashes = calloc(hash_capacity, sizeof(uint64_t));
+    group->encoded = malloc((size_t)n * BOARD_CODEC_MAX_BYTES);
+    group->encoded_sizes = calloc(n, sizeof(uint16_t));
+    pthread_mutex_init(&group->lock, NULL);
+
+    return group->hashes && group->encoded && group->encoded_sizes;
+}
+
+static void builder_group_free(BuilderGroup* group) {
+    pthread_mutex_destroy(&group->lock);
+    free(group->hashes);
+    free(group->encoded);
+    free(group->encoded_sizes);
+}
+
+static void builder_report(const Builder* builder, uint64_t wall_ns, const uint32_t* steals) {
+    printf("\n%-10s %-7s %6s %6s %5s %9s %11s %11s\n",
+           "size",
+           "level",
+           "mines",
+           "boards",
+           "dups",
+           "att/board",
+           "boards/core",
+           "bytes/board");
+
+    for (uint32_t g = 0; g < builder->group_count; ++g) {
+        const BuilderGroup* group = &builder->groups[g];
+        char size[16];
+        snprintf(size, sizeof(size), "%ux%u", group->config.width, group->config.height);
+
+        const double core_s = (double)group->busy_ns / 1e9;
+        const uint32_t generated = group->accepted + group->duplicates;
+        printf("%-10s %-7s %6u %6" PRIu32 " %5" PRIu32 " %9.1f %9.1f/s %11u%s\n",
+               size,
+               difficulty_names[group->config.difficulty],
+               group->mine_count,
+               group->accepted,
+               group->duplicates,
+               generated ? (double)group->attempts / generated : 0.0,
+               core_s > 0 ? generated / core_s : 0.0,
+               builder_group_stride(group),
+               group->exhausted ? "  (ran out of distinct layouts)" : "");
+    }
+
+    uint32_t total_steals = 0;
+    for (uint32_t t = 0; t < builder->thread_count; ++t) total_steals += steals[t];
+
+    const double wall_s = (double)wall_ns / 1e9;
+    const uint32_t done = (uint32_t)atomic_load(&builder->boards_done);
+    printf("\n%" PRIu32 " boards in %.2fs on %" PRIu32 " threads: %.1f boards/s, %" PRIu32
+           " steals\n",
+           done,
+           wall_s,
+           builder->thread_count,
+           wall_s > 0 ? done / wall_s : 0.0,
+           total_steals);
+}
+
+int main(int argc, char** argv) {
+    const char* output = "boards.pack";
+    uint32_t boards_per_group = BUILDER_DEFAULT_BOARDS;
+    long online = sysconf(_SC_NPROCESSORS_ONLN);
+    uint32_t thread_count = online > 0 ? (uint32_t)online : 1u;
+    uint64_t seed = builder_now_ns() ^ ((uint64_t)getpid() << 32);
+    int opt;
+
+    while ((opt = getopt(argc, argv, "o:n:j:s:h")) != -1) {
+        switch (opt) {
+        case 'o':
+            output = optarg;
+            break;
+        case 'n':
+            boards_per_group = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case 'j':
+            thread_count = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case 's':
+            seed = strtoull(optarg, NULL, 0);
+            break;
+        default:
+            builder_usage(argv[0]);
+            return opt == 'h' ? 0 : 2;
+        }
+    }
+
+    const uint32_t group_count = (uint32_t)(argc - optind);
+    if (group_count == 0 || group_count > BOARD_PACK_MAX_GROUPS || boards_per_group == 0 ||
+        thread_count == 0 || thread_count > BUILDER_MAX_THREADS) {
+        builder_usage(argv[0]);
+        return 2;
+    }
+
+    Builder builder = {
+        .groups = calloc(group_count, sizeof(BuilderGroup)),
+        .group_count = group_count,
+        .deques = calloc(thread_count, sizeof(BuilderDeque)),
+        .thread_count = thread_count,
+        .seed = seed,
+        .boards_total = group_count * boards_per_group,
+    };
+    furi_check(builder.groups && builder.deques);
+    atomic_init(&builder.failed, false);
+    atomic_init(&builder.boards_done, 0u);
+
+    for (uint32_t g = 0; g < group_count; ++g) {
+        MineSweeperConfig config;
+        if (!builder_parse_group(argv[optind + g], &config)) {
+            fprintf(stderr, "bad group '%s'\n", argv[optind + g]);
+            builder_usage(argv[0]);
+            return 2;
+        }
+        for (uint32_t other = 0; other < g; ++other) {
+            const MineSweeperConfig* seen = &builder.groups[other].config;
+            if (seen->width == config.width && seen->height == config.height &&
+                seen->difficulty == config.difficulty) {
+                fprintf(stderr, "group '%s' is listed twice\n", argv[optind + g]);
+                return 2;
+            }
+        }
+        furi_check(builder_group_init(&builder.groups[g], &config, boards_per_group));
+    }
+
+    for (uint32_t t = 0; t < thread_count; ++t) {
+        pthread_mutex_init(&builder.deques[t].lock, NULL);
+    }
+
+    // Deal tasks round robin across groups first, so every thread starts with a mix.
+    uint32_t next_deque = 0;
+    for (uint32_t dealt = 0; dealt < boards_per_group; dealt += BUILDER_TASK_BOARDS) {
+        const uint32_t boards = boards_per_group - dealt < BUILDER_TASK_BOARDS ?
+                                    boards_per_group - dealt :
+                                    BUILDER_TASK_BOARDS;
+        for (uint32_t g = 0; g < group_count; ++g) {
+            const BuilderTask task = {.group = g, .boards = boards};
+            builder_deque_push(&builder.deques[next_deque], task);
+            next_deque = (next_deque + 1u) % thread_count;
+        }
+    }
+
+    printf("building %" PRIu32 " groups x %" PRIu32 " boards on %" PRIu32
+           " threads (seed 0x%016" PRIx64 ")\n",
+           group_count,
+           boards_per_group,
+           thread_count,
+           seed);
+
+    pthread_t* threads = calloc(thread_count, sizeof(pthread_t));
+    BuilderWorker* workers = calloc(thread_count, sizeof(BuilderWorker));
+    uint32_t* steals = calloc(thread_count, sizeof(uint32_t));
+    furi_check(threads && workers && steals);
+
+    const uint64_t started = builder_now_ns();
+    for (uint32_t t = 0; t < thread_count; ++t) {
+        workers[t].builder = &builder;
+        workers[t].index = t;
+        furi_check(pthread_create(&threads[t], NULL, builder_worker_thread, &workers[t]) == 0);
+    }
+
+    uint32_t last_reported = UINT32_MAX;
+    for (;;) {
+        const uint32_t done = (uint32_t)atomic_load(&builder.boards_done);
+        bool idle = true;
+        for (uint32_t t = 0; t < thread_count && idle; ++t) {
+            pthread_mutex_lock(&builder.deques[t].lock);
+            idle = builder.deques[t].tail == builder.deques[t].head;
+            pthread_mutex_unlock(&builder.deques[t].lock);
+        }
+        if (isatty(STDOUT_FILENO) && done != last_reported) {
+            printf("\r%" PRIu32 "/%" PRIu32 " boards", done, builder.boards_total);
+            fflush(stdout);
+            last_reported = done;
+        }
+        if (idle || atomic_load(&builder.failed)) break;
+        usleep(200000);
+    }
+
+    for (uint32_t t = 0; t < thread_count; ++t) {
+        pthread_join(threads[t], NULL);
+        steals[t] = workers[t].steals;
+    }
+    const uint64_t wall_ns = builder_now_ns() - started;
+
+    int status = 1;
+    if (!atomic_load(&builder.failed)) {
+        builder_report(&builder, wall_ns, steals);
+        if (builder_write_pack(&builder, output)) {
+            printf("wrote %s\n", output);
+            status = 0;
+        }
+    }
+
+    for (uint32_t g = 0; g < group_count; ++g) builder_group_free(&builder.groups[g]);
+    for (uint32_t t = 0; t < thread_count; ++t) {
+        pthread_mutex_destroy(&builder.deques[t].lock);
+        free(builder.deques[t].tasks);
+    }
+    free(builder.groups);
+    free(builder.deques);
+    free(threads);
+    free(workers);
+    free(steals);
+
+    return status;
+}
@@ -0,0 +1,50 @@
+#ifndef HOST_SHIM_FURI_H
+#define HOST_SHIM_FURI_H
+
+/** Just enough of furi to build engine/ on a desktop host.
+  *
+  * Only what the engine sources actually use is provided. Assertions stay on
+  * regardless of NDEBUG, like furi_check on the device, so a broken board fails
+  * loudly instead of ending up in a pack.
+  */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+
+#define UNUSED(x) (void)(x)
+
+#define furi_crash(message)                                                       \
+    do {                                                                          \
+        fprintf(stderr, "furi_crash: %s (%s:%d)\n", message, __FILE__, __LINE__); \
+        abort();                                                                  \
+    } while (0)
+
+#define furi_check(expr)                               \
+    do {                                               \
+        if (!(expr)) furi_crash("check failed: " #expr); \
+    } while (0)
+
+#define furi_assert(expr) furi_check(expr)
+
+#define FURI_LOG_E(tag, format, ...) \
+    fprintf(stderr, "[E][%s] " format "\n", tag, ##__VA_ARGS__)
+#define FURI_LOG_W(tag, format, ...) \
+    fprintf(stderr, "[W][%s] " format "\n", tag, ##__VA_ARGS__)
+#define FURI_LOG_I(tag, format, ...) \
+    fprintf(stderr, "[I][%s] " format "\n", tag, ##__VA_ARGS__)
+#define FURI_LOG_D(tag, format, ...) ((void)0)
+
+// Milliseconds since the first call.
+uint32_t furi_get_tick(void);
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+#endif // HOST_SHIM_FURI_H
@@ -0,0 +1,33 @@
+#ifndef HOST_SHIM_FURI_HAL_H
+#define HOST_SHIM_FURI_HAL_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+
+/* Per-thread xoshiro128** stream. Seed it on each thread before generating,
+ * otherwise every thread draws the same boards. */
+void furi_hal_random_seed(uint64_t seed);
+
+uint32_t furi_hal_random_get(void);
+
+/* The engine only reads .start as a free running cycle counter, so the host
+ * maps it onto the monotonic clock at HOST_SHIM_CYCLES_PER_US. */
+typedef struct {
+    uint32_t start;
+    uint32_t value;
+} FuriHalCortexTimer;
+
+#define HOST_SHIM_CYCLES_PER_US (64u)
+
+FuriHalCortexTimer furi_hal_cortex_timer_get(uint32_t timeout_us);
+
+uint32_t furi_hal_cortex_instructions_per_microsecond(void);
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+#endif // HOST_SHIM_FURI_HAL_H
@@ -0,0 +1,69 @@
+#include "furi.h"
+#include "furi_hal.h"
+
+#include <stdatomic.h>
+#include <time.h>
+
+static _Thread_local uint32_t random_state[4] = {0x9E3779B9u, 0x243F6A88u, 0xB7E15162u, 0x1u};
+
+static uint64_t shim_now_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000u + (uint64_t)ts.tv_nsec / 1000u;
+}
+
+static uint64_t shim_splitmix64(uint64_t* x) {
+    uint64_t z = (*x += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+static inline uint32_t shim_rotl(uint32_t x, int k) {
+    return (x << k) | (x >> (32 - k));
+}
+
+uint32_t furi_get_tick(void) {
+    static _Atomic uint64_t epoch_us = 0;
+    const uint64_t now_us = shim_now_us();
+    uint64_t expected = 0;
+    // The first caller on any thread fixes the epoch.
+    atomic_compare_exchange_strong(&epoch_us, &expected, now_us);
+    return (uint32_t)((now_us - atomic_load(&epoch_us)) / 1000u);
+}
+
+void furi_hal_random_seed(uint64_t seed) {
+    const uint64_t a = shim_splitmix64(&seed);
+    const uint64_t b = shim_splitmix64(&seed);
+    random_state[0] = (uint32_t)a;
+    random_state[1] = (uint32_t)(a >> 32);
+    random_state[2] = (uint32_t)b;
+    random_state[3] = (uint32_t)(b >> 32) | 1u; // never all zero
+}
+
+uint32_t furi_hal_random_get(void) {
+    uint32_t* s = random_state;
+    const uint32_t result = shim_rotl(s[1] * 5u, 7) * 9u;
+    const uint32_t t = s[1] << 9;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = shim_rotl(s[3], 11);
+
+    return result;
+}
+
+FuriHalCortexTimer furi_hal_cortex_timer_get(uint32_t timeout_us) {
+    FuriHalCortexTimer timer = {
+        .start = (uint32_t)(shim_now_us() * HOST_SHIM_CYCLES_PER_US),
+        .value = timeout_us * HOST_SHIM_CYCLES_PER_US,
+    };
+    return timer;
+}
+
+uint32_t furi_hal_cortex_instructions_per_microsecond(void) {
+    return HOST_SHIM_CYCLES_PER_US;
+}
@@ -31,6 +31,7 @@ struct MineSweeperGameScreen {
 
 typedef struct {
     MineSweeperState* game_state;
+    const MineSweeperHintState* hint;
 
     // Used to track the projection of the board
     uint8_t right_boundary;
@@ -69,6 +70,39 @@ static void mine_sweeper_game_screen_format_elapsed(FuriString* out, uint32_t el
     furi_string_printf(out, "%02lu:%02lu", (unsigned long)minutes, (unsigned long)seconds);
 }
 
+// Status text for the hint, if there is one to show for the tile under the cursor.
+static bool mine_sweeper_game_screen_format_hint(
+    MineSweeperGameScreenModel* model,
+    const MineSweeperState* game_state) {
+    furi_assert(model);
+    furi_assert(game_state);
+
+    if (!model->hint) {
+        return false;
+    }
+
+    switch (model->hint->phase) {
+    case MineSweeperHintPhaseRunning:
+        furi_string_set_str(model->info_str, "Hint...");
+        return true;
+    case MineSweeperHintPhaseInconsistent:
+        furi_string_set_str(model->info_str, "Bad flag?");
+        return true;
+    case MineSweeperHintPhaseIdle:
+    case MineSweeperHintPhaseReady: {
+        const int8_t percent = hint_tile_percent(
+            model->hint, &game_state->board, game_state->rt.cursor_col, game_state->rt.cursor_row);
+        if (percent < 0) {
+            return false;
+        }
+        furi_string_printf(model->info_str, "Mine:%d%%", percent);
+        return true;
+    }
+    default:
+        return false;
+    }
+}
+
 static void
     move_projection_boundary(MineSweeperState* game_state, MineSweeperGameScreenModel* model) {
     int16_t top_boundary = (int16_t)model->bottom_boundary - MINESWEEPER_SCREEN_TILE_HEIGHT;
@@ -274,7 +308,19 @@ static void mine_sweeper_game_screen_draw_callback(Canvas* canvas, void* _model)
         canvas_draw_line(canvas, 0, 0, 127, 0);
     }
 
-    if (game_state->rt.phase == MineSweeperPhasePlaying) {
+    if (game_state->rt.phase == MineSweeperPhasePlaying &&
+        mine_sweeper_game_screen_format_hint(model, game_state)) {
+        // Hint text takes the place of the cursor position
+        canvas_draw_str_aligned(
+            canvas, 0, 64 - 7, AlignLeft, AlignTop, furi_string_get_cstr(model->info_str));
+
+        // Draw flag text
+        furi_string_printf(model->info_str, "F:%03hd", game_state->rt.flags_left);
+
+        canvas_draw_str_aligned(
+            canvas, 66, 64 - 7, AlignLeft, AlignTop, furi_string_get_cstr(model->info_str));
+
+    } else if (game_state->rt.phase == MineSweeperPhasePlaying) {
         // Draw X Position Text
         furi_string_printf(model->info_str, "X:%03hhd", game_state->rt.cursor_col);
 
@@ -405,6 +451,19 @@ void mine_sweeper_game_screen_update_clock(MineSweeperGameScreen* instance) {
         need_redraw);
 }
 
+void mine_sweeper_game_screen_set_hint(
+    MineSweeperGameScreen* instance,
+    const MineSweeperHintState* hint) {
+    furi_assert(instance);
+    with_view_model(
+        instance->view,
+        MineSweeperGameScreenModel * model,
+        {
+            model->hint = hint;
+        },
+        true);
+}
+
 View* mine_sweeper_game_screen_get_view(MineSweeperGameScreen* instance) {
     furi_assert(instance);
     return instance->view;
@@ -9,6 +9,7 @@
 #include <gui/view.h>
 #include <input/input.h>
 #include "engine/mine_sweeper_engine.h"
+#include "engine/mine_sweeper_hint.h"
 
 // These defines represent how many tiles
 // can be visually representen on the screen
@@ -82,6 +83,19 @@ void mine_sweeper_game_screen_set_context(
     MineSweeperGameScreen* instance,
     MineSweeperState* context);
 
+/** Set the hint shown in the status bar
+ *
+ * While the hint is being worked out the status bar says so, and once it is
+ * ready it shows the mine chance of the hidden tile under the cursor. A tile
+ * a sure hint pointed at shows 0% or 100% until the board changes.
+ *
+ * @param       instance    MineSweeperGameScreen* instance
+ * @param       hint        const MineSweeperHintState*, owned by the caller, or NULL
+ */
+void mine_sweeper_game_screen_set_hint(
+    MineSweeperGameScreen* instance,
+    const MineSweeperHintState* hint);
+
 #define inverted_canvas_white_to_black(canvas, code) \
     {                                                \
         canvas_set_color(canvas, ColorWhite);        \
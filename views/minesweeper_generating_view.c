@@ -13,6 +13,8 @@ struct MineSweeperGeneratingView {
 typedef struct {
     uint32_t attempts_total;
     uint32_t elapsed_seconds;
+    uint32_t eta_seconds; // UINT32_MAX while there is no estimate yet
+    bool waiting; // forced start asked for, no board yet
 } MineSweeperGeneratingViewModel;
 
 static void minesweeper_generating_view_draw(Canvas* canvas, void* _model) {
@@ -29,7 +31,7 @@ static void minesweeper_generating_view_draw(Canvas* canvas, void* _model) {
     canvas_set_font(canvas, FontSecondary);
     char line[32];
 
-    canvas_draw_str_aligned(canvas, 64, 24, AlignCenter, AlignTop, "Solvable from 0,0");
+    canvas_draw_str_aligned(canvas, 64, 24, AlignCenter, AlignTop, "Solvable from start");
 
     snprintf(line, sizeof(line), "Attempts: %lu", (unsigned long)model->attempts_total);
     canvas_draw_str_aligned(canvas, 2, 34, AlignLeft, AlignTop, line);
@@ -37,7 +39,24 @@ static void minesweeper_generating_view_draw(Canvas* canvas, void* _model) {
     snprintf(line, sizeof(line), "Elapsed:  %lus", (unsigned long)model->elapsed_seconds);
     canvas_draw_str_aligned(canvas, 2, 44, AlignLeft, AlignTop, line);
 
-    canvas_draw_str_aligned(canvas, 64, 63, AlignCenter, AlignBottom, "OK: Force start now");
+    if (model->eta_seconds == UINT32_MAX) {
+        snprintf(line, sizeof(line), "ETA: ...");
+    } else if (model->eta_seconds == 0) {
+        snprintf(line, sizeof(line), "ETA: soon");
+    } else if (model->eta_seconds < 600) {
+        snprintf(line, sizeof(line), "ETA: ~%lus", (unsigned long)model->eta_seconds);
+    } else {
+        snprintf(line, sizeof(line), "ETA: ~%lum", (unsigned long)(model->eta_seconds / 60));
+    }
+    canvas_draw_str_aligned(canvas, 126, 44, AlignRight, AlignTop, line);
+
+    canvas_draw_str_aligned(
+        canvas,
+        64,
+        63,
+        AlignCenter,
+        AlignBottom,
+        model->waiting ? "Waiting for a board..." : "OK: Force start now");
 }
 
 static bool minesweeper_generating_view_input(InputEvent* event, void* context) {
@@ -85,6 +104,8 @@ MineSweeperGeneratingView* minesweeper_generating_view_alloc(void) {
         {
             model->attempts_total = 0;
             model->elapsed_seconds = 0;
+            model->eta_seconds = UINT32_MAX;
+            model->waiting = false;
         },
         true);
 
@@ -123,7 +144,8 @@ void minesweeper_generating_view_set_input_callback(
 void minesweeper_generating_view_set_stats(
     MineSweeperGeneratingView* instance,
     uint32_t attempts_total,
-    uint32_t elapsed_seconds) {
+    uint32_t elapsed_seconds,
+    uint32_t eta_seconds) {
     furi_assert(instance);
 
     with_view_model(
@@ -132,10 +154,21 @@ void minesweeper_generating_view_set_stats(
         {
             model->attempts_total = attempts_total;
             model->elapsed_seconds = elapsed_seconds;
+            model->eta_seconds = eta_seconds;
         },
         true);
 }
 
+void minesweeper_generating_view_set_waiting(MineSweeperGeneratingView* instance, bool waiting) {
+    furi_assert(instance);
+
+    with_view_model(
+        instance->view,
+        MineSweeperGeneratingViewModel * model,
+        { model->waiting = waiting; },
+        true);
+}
+
 void minesweeper_generating_view_reset(MineSweeperGeneratingView* instance) {
     furi_assert(instance);
 
@@ -145,6 +178,8 @@ void minesweeper_generating_view_reset(MineSweeperGeneratingView* instance) {
         {
             model->attempts_total = 0;
             model->elapsed_seconds = 0;
+            model->eta_seconds = UINT32_MAX;
+            model->waiting = false;
         },
         true);
 
@@ -27,10 +27,15 @@ void minesweeper_generating_view_set_input_callback(
     MineSweeperGeneratingView* instance,
     MineSweeperGeneratingInputCallback callback);
 
+/* eta_seconds is UINT32_MAX while there is no estimate yet. */
 void minesweeper_generating_view_set_stats(
     MineSweeperGeneratingView* instance,
     uint32_t attempts_total,
-    uint32_t elapsed_seconds);
+    uint32_t elapsed_seconds,
+    uint32_t eta_seconds);
+
+/* Shown after a forced start, while there is no board to start on yet. */
+void minesweeper_generating_view_set_waiting(MineSweeperGeneratingView* instance, bool waiting);
 
 void minesweeper_generating_view_reset(MineSweeperGeneratingView* instance);
 